@@ -0,0 +1,116 @@
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "mapped_bit_grid.hpp"
+#include "out_of_core_engine.hpp"
+
+namespace {
+
+/// @brief Measures the time of a callable in seconds.
+template <typename Function>
+double Measure(Function&& function) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+  return elapsed.count();
+}
+
+/// @brief Gets the peak resident set size of the process in MiB.
+double PeakRssMiB() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  constexpr double kKiBPerMiB{1024.0};
+  return static_cast<double>(usage.ru_maxrss) / kKiBPerMiB;
+}
+
+/// @brief Gets the physical memory in MiB.
+double PhysicalMemoryMiB() {
+  constexpr double kBytesPerMiB{1024.0 * 1024.0};
+  return static_cast<double>(sysconf(_SC_PHYS_PAGES)) * static_cast<double>(sysconf(_SC_PAGESIZE)) / kBytesPerMiB;
+}
+
+}  // namespace
+
+/// @brief Measures the throughput and the peak RSS of the out-of-core engine.
+///
+/// Usage: benchmark_out_of_core [width] [height] [generations] [directory] [band_rows]
+///
+/// The board takes width * height / 8 bytes per file. By default it is a square board of three times the physical
+/// memory. Two files of that size are created in the directory and removed at the end.
+int main(int argc, char** argv) {
+  // Side of a square board of three times the physical memory, rounded down to whole words.
+  constexpr double kMemoryFactor{3.0};
+  constexpr double kBitsPerMiB{8.0 * 1024.0 * 1024.0};
+  const auto default_side = static_cast<std::size_t>(std::sqrt(kMemoryFactor * PhysicalMemoryMiB() * kBitsPerMiB)) /
+                            host::BitGrid::kWordBits * host::BitGrid::kWordBits;
+
+  const std::size_t width{(argc > 1) ? std::strtoull(argv[1], nullptr, 10) : default_side};
+  const std::size_t height{(argc > 2) ? std::strtoull(argv[2], nullptr, 10) : default_side};
+  const std::size_t generations{(argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 3U};
+  const std::string directory{(argc > 4) ? argv[4] : "."};
+  const std::size_t band_rows{(argc > 5) ? std::strtoull(argv[5], nullptr, 10) : 256U};
+
+  const std::string current_path{directory + "/out_of_core_a.bin"};
+  const std::string next_path{directory + "/out_of_core_b.bin"};
+  const double board_mib{static_cast<double>(host::BitGrid::WordsPerRow(width) * height * sizeof(std::uint64_t)) /
+                         (1024.0 * 1024.0)};
+  std::printf("Board %zux%zu, %.0f MiB per file, %.0f MiB physical memory, bands of %zu rows\n", width, height,
+              board_mib, PhysicalMemoryMiB(), band_rows);
+  if (board_mib < PhysicalMemoryMiB()) {
+    std::printf("Warning: the board fits in the physical memory, the page cache may hide the cost of the I/O\n");
+  }
+
+  auto grid = host::MappedBitGrid::Create(current_path, width, height);
+  if (!grid) {
+    std::printf("Cannot create %s\n", current_path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  const double init_seconds{Measure([&]() { grid->Randomize(1U, band_rows); })};
+  std::printf("Initialization   %8.3f s\n", init_seconds);
+
+  auto engine = host::OutOfCoreEngine::Create(std::move(*grid), next_path, band_rows);
+  if (!engine) {
+    std::printf("Cannot create %s\n", next_path.c_str());
+    std::remove(current_path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  // The first generation writes into freshly allocated blocks. Only the following ones, which overwrite the generation
+  // before last, show the steady state.
+  const double cells{static_cast<double>(width) * static_cast<double>(height)};
+  double steady_seconds{0.0};
+  int status{EXIT_SUCCESS};
+  for (std::size_t i{0U}; i < generations; ++i) {
+    bool written{false};
+    const double seconds{Measure([&]() { written = engine->Advance(1U); })};
+    if (!written) {
+      std::printf("Cannot write generation %zu\n", i + 1U);
+      status = EXIT_FAILURE;
+      break;
+    }
+    steady_seconds += (i > 0U) ? seconds : 0.0;
+    std::printf("Generation %-5zu %8.3f s %10.3f Mcells/s\n", i + 1U, seconds, cells / seconds * 1e-6);
+  }
+
+  if ((status == EXIT_SUCCESS) && (generations > 1U)) {
+    const auto steady_generations = static_cast<double>(generations - 1U);
+    std::printf("Steady state     %8.3f s %10.3f Mcells/s (generations 2 to %zu)\n",
+                steady_seconds / steady_generations, cells * steady_generations / steady_seconds * 1e-6, generations);
+  }
+  std::printf("Peak RSS         %8.1f MiB (%.1f%% of the board)\n", PeakRssMiB(), PeakRssMiB() / board_mib * 100.0);
+
+  engine.reset();
+  std::remove(current_path.c_str());
+  std::remove(next_path.c_str());
+  return status;
+}
@@ -0,0 +1,110 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <ostream>
+#include <streambuf>
+#include <utility>
+
+#include "bit_grid.hpp"
+#include "frame_consumers.hpp"
+#include "frame_pipeline.hpp"
+#include "snapshot_ring.hpp"
+
+namespace {
+
+/// @brief Stream buffer discarding everything, so that the benchmark does not depend on the disk.
+class NullBuffer : public std::streambuf {
+ protected:
+  int_type overflow(int_type character) override { return character; }
+  std::streamsize xsputn(const char_type* /*data*/, std::streamsize count) override { return count; }
+};
+
+/// @brief Measures the time of a callable in seconds.
+template <typename Function>
+double Measure(Function&& function) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+  return elapsed.count();
+}
+
+/// @brief Runs the simulation and calls @p output after each generation.
+/// @return The time spent in the simulation loop in seconds.
+template <typename Output>
+double Simulate(const host::BitGrid& initial, std::size_t generations, Output&& output) {
+  host::BitGrid grid{initial};
+  host::BitGrid next(initial.GetWidth(), initial.GetHeight());
+  return Measure([&]() {
+    for (std::size_t i{0U}; i < generations; ++i) {
+      host::StepGeneration(grid, next);
+      std::swap(grid, next);
+      output(i, grid);
+    }
+  });
+}
+
+/// @brief Prints one result line.
+void Report(const char* name, std::size_t generations, double seconds, double baseline_seconds) {
+  std::printf("%-22s %8.3f s %10.1f generations/s  x%.2f\n", name, seconds, static_cast<double>(generations) / seconds,
+              baseline_seconds / seconds);
+}
+
+}  // namespace
+
+/// @brief Measures the cost of the output stages for the simulation thread.
+///
+/// Usage: benchmark_pipeline [width] [height] [generations]
+///
+/// Each generation is written as a PBM image to a discarding stream and its population is counted, either inline after
+/// each generation or by a pipeline with one thread per consumer.
+int main(int argc, char** argv) {
+  const std::size_t width{(argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1024U};
+  const std::size_t height{(argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1024U};
+  const std::size_t generations{(argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 200U};
+
+  host::BitGrid initial(width, height);
+  initial.Randomize(1U);
+  std::printf("Board %zux%zu, %zu generations\n", width, height, generations);
+
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+
+  const double baseline_seconds{Simulate(initial, generations, [](std::uint64_t, const host::BitGrid&) {})};
+  Report("no output", generations, baseline_seconds, baseline_seconds);
+
+  {
+    host::PbmWriter<host::BitGrid> writer(null_stream, initial);
+    host::PopulationStats<host::BitGrid> stats;
+    const double seconds{Simulate(initial, generations, [&](std::uint64_t generation, const host::BitGrid& grid) {
+      writer(generation, grid);
+      stats(generation, grid);
+    })};
+    Report("inline output", generations, seconds, baseline_seconds);
+  }
+
+  constexpr std::size_t kCapacity{8U};
+  const std::pair<const char*, host::BackpressurePolicy> kPolicies[] = {
+      {"pipeline, drop-oldest", host::BackpressurePolicy::kDropOldest},
+      {"pipeline, block", host::BackpressurePolicy::kBlock},
+  };
+  for (const auto& [name, policy] : kPolicies) {
+    host::PopulationStats<host::BitGrid> stats;
+    host::FramePipeline<host::BitGrid> pipeline(kCapacity, initial);
+    auto& pbm_stage = pipeline.AddStage(policy, host::PbmWriter<host::BitGrid>(null_stream, initial));
+    auto& stats_stage = pipeline.AddStage(policy, std::ref(stats));
+
+    const double seconds{Simulate(initial, generations, [&](std::uint64_t generation, const host::BitGrid& grid) {
+      pipeline.Publish(generation, grid);
+    })};
+    Report(name, generations, seconds, baseline_seconds);
+
+    pipeline.Stop();
+    std::printf("  dropped: pbm %llu, stats %llu\n", static_cast<unsigned long long>(pbm_stage.GetDropped()),
+                static_cast<unsigned long long>(stats_stage.GetDropped()));
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <utility>
+
+#include "bit_grid.hpp"
+#include "temporal_blocking_engine.hpp"
+
+namespace {
+
+/// @brief Measures the time of a callable in seconds.
+template <typename Function>
+double Measure(Function&& function) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+  return elapsed.count();
+}
+
+/// @brief Prints one result line.
+void Report(const char* name, const host::TemporalBlockingConfig& config, double cell_updates, double seconds,
+            double baseline_rate) {
+  const double rate{cell_updates / seconds};
+  std::printf("%-10s K=%-3zu tile=%5zux%-4zu %8.3f s %10.3f Gcells/s  x%.2f\n", name, config.generations_per_pass,
+              config.tile_width, config.tile_height, seconds, rate * 1e-9, rate / baseline_rate);
+}
+
+/// @brief Gets the size of the last-level cache in bytes, or zero if it is unknown.
+std::size_t LastLevelCacheBytes() {
+  for (const int name : {_SC_LEVEL4_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+    const long size{sysconf(name)};
+    if (size > 0) {
+      return static_cast<std::size_t>(size);
+    }
+  }
+  return 0U;
+}
+
+}  // namespace
+
+/// @brief Compares the one-generation-per-pass path with the temporal blocking engine.
+///
+/// Usage: benchmark_temporal_blocking [width] [height] [generations]
+///
+/// By default the board is a square of four times the last-level cache per generation, so that the streaming path
+/// reads and writes the memory rather than the cache.
+int main(int argc, char** argv) {
+  // Side of a square board of four times the last-level cache, rounded down to whole words. 32 MiB if unknown.
+  constexpr double kCacheFactor{4.0};
+  constexpr std::size_t kUnknownCacheBytes{std::size_t{32U} << 20U};
+  std::size_t cache_bytes{LastLevelCacheBytes()};
+  if (cache_bytes == 0U) {
+    cache_bytes = kUnknownCacheBytes;
+  }
+  const auto default_side = static_cast<std::size_t>(std::sqrt(kCacheFactor * static_cast<double>(cache_bytes) * 8.0)) /
+                            host::BitGrid::kWordBits * host::BitGrid::kWordBits;
+
+  const std::size_t width{(argc > 1) ? std::strtoull(argv[1], nullptr, 10) : default_side};
+  const std::size_t height{(argc > 2) ? std::strtoull(argv[2], nullptr, 10) : default_side};
+  const std::size_t generations{(argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 8U};
+  const double cell_updates{static_cast<double>(width) * static_cast<double>(height) *
+                            static_cast<double>(generations)};
+
+  host::BitGrid initial(width, height);
+  initial.Randomize(1U);
+  std::printf("Board %zux%zu (%zu MiB per generation, %zu MiB last-level cache), %zu generations\n", width, height,
+              (initial.GetRowWords() * height * sizeof(host::BitGrid::Word)) >> 20U, cache_bytes >> 20U, generations);
+
+  host::BitGrid reference{initial};
+  const double baseline_seconds{Measure([&]() {
+    host::BitGrid next(width, height);
+    for (std::size_t i{0U}; i < generations; ++i) {
+      host::StepGeneration(reference, next);
+      std::swap(reference, next);
+    }
+  })};
+  const double baseline_rate{cell_updates / baseline_seconds};
+  Report("streaming", {1U, width, height}, cell_updates, baseline_seconds, baseline_rate);
+
+  // The default configuration comes first, so that the out-of-the-box behavior is always measured.
+  const host::TemporalBlockingConfig kConfigs[] = {
+      host::TemporalBlockingConfig{},
+      {1U, 16384U, 128U},
+      {4U, 16384U, 128U},
+      {16U, 16384U, 128U},
+      {8U, 8192U, 256U},
+      {8U, 65536U, 64U},
+      {8U, 4096U, 256U},
+      {8U, 2048U, 64U},
+  };
+
+  int status{EXIT_SUCCESS};
+  for (const auto& config : kConfigs) {
+    host::TemporalBlockingEngine engine(initial, config);
+    const double seconds{Measure([&]() { engine.Advance(generations); })};
+    Report("blocked", config, cell_updates, seconds, baseline_rate);
+
+    if (engine.GetGrid() != reference) {
+      std::printf("  result differs from the streaming path\n");
+      status = EXIT_FAILURE;
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,311 @@
+#ifndef FIRMWARE_BIT_PACKED_GAME_OF_LIFE_HPP_
+#define FIRMWARE_BIT_PACKED_GAME_OF_LIFE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+namespace bit_packed {
+namespace details {
+
+/// @brief Per-cell sums of up to three cells, bit-sliced: @c ones holds bit 0 of every sum and @c twos bit 1.
+template <typename Word>
+struct BitSlicedSum {
+  /// @brief Bit 0 of the sums.
+  Word ones;
+  /// @brief Bit 1 of the sums.
+  Word twos;
+};
+
+/// @brief Adds three words cell by cell with a full adder.
+template <typename Word>
+constexpr BitSlicedSum<Word> AddThree(Word first, Word second, Word third) noexcept {
+  const auto partial = static_cast<Word>(first ^ second);
+  return {static_cast<Word>(partial ^ third), static_cast<Word>((first & second) | (partial & third))};
+}
+
+/// @brief Computes the next generation of the cells of a word.
+///
+/// The eight neighbors are summed with bit-sliced full adders, so all the cells of the word are updated at once and
+/// the cost does not depend on the number of living cells.
+///
+/// @param above_prev,above,above_succ The word above and its left and right neighbor words.
+/// @param prev,current,succ The word to update and its left and right neighbor words.
+/// @param below_prev,below,below_succ The word below and its left and right neighbor words.
+/// @return The next generation of the word.
+template <typename Word>
+constexpr Word NextWord(Word above_prev, Word above, Word above_succ, Word prev, Word current, Word succ,
+                        Word below_prev, Word below, Word below_succ) noexcept {
+  constexpr auto kLastBit{static_cast<unsigned>(std::numeric_limits<Word>::digits - 1)};
+
+  // The least significant bit is the leftmost cell, so the left neighbors are the word shifted towards the most
+  // significant bit, with the last cell of the previous word shifted in.
+  const auto left = [](Word previous, Word word) { return static_cast<Word>((word << 1U) | (previous >> kLastBit)); };
+  const auto right = [](Word word, Word next) { return static_cast<Word>((word >> 1U) | (next << kLastBit)); };
+
+  const auto top = AddThree(left(above_prev, above), above, right(above, above_succ));
+  const auto bottom = AddThree(left(below_prev, below), below, right(below, below_succ));
+  const Word middle_left{left(prev, current)};
+  const Word middle_right{right(current, succ)};
+
+  // Bit 0 of the number of neighbors, and the carries into bit 1.
+  const auto low = AddThree(top.ones, bottom.ones, static_cast<Word>(middle_left ^ middle_right));
+  const auto high = AddThree(top.twos, bottom.twos, static_cast<Word>(middle_left & middle_right));
+
+  // Bit 1 of the number of neighbors, and whether the number reaches four.
+  const auto twos = static_cast<Word>(high.ones ^ low.twos);
+  const auto many = static_cast<Word>(high.twos | (high.ones & low.twos));
+
+  // A cell is alive with three neighbors, or with two neighbors if it was alive already.
+  return static_cast<Word>(twos & ~many & (low.ones | current));
+}
+
+/// @brief Implementation of @c NextRow, specialized on the presence of the rows above and below.
+template <bool kHasAbove, bool kHasBelow, typename Word>
+void NextRow(const Word* above, const Word* current, const Word* below, Word* next, std::size_t words,
+             Word last_word_mask) noexcept {
+  const auto above_at = [above](std::size_t index) { return kHasAbove ? above[index] : Word{0U}; };
+  const auto below_at = [below](std::size_t index) { return kHasBelow ? below[index] : Word{0U}; };
+
+  if (words == 1U) {
+    next[0] = static_cast<Word>(NextWord<Word>(0U, above_at(0U), 0U, 0U, current[0], 0U, 0U, below_at(0U), 0U) &
+                                last_word_mask);
+    return;
+  }
+
+  // The first and last words have dead neighbors outside the row, the loop in between runs without any branch.
+  const std::size_t last{words - 1U};
+  next[0] = NextWord<Word>(0U, above_at(0U), above_at(1U), 0U, current[0], current[1], 0U, below_at(0U), below_at(1U));
+  for (std::size_t index{1U}; index < last; ++index) {
+    next[index] = NextWord(above_at(index - 1U), above_at(index), above_at(index + 1U), current[index - 1U],
+                           current[index], current[index + 1U], below_at(index - 1U), below_at(index),
+                           below_at(index + 1U));
+  }
+  next[last] = static_cast<Word>(NextWord<Word>(above_at(last - 1U), above_at(last), 0U, current[last - 1U],
+                                                current[last], 0U, below_at(last - 1U), below_at(last), 0U) &
+                                 last_word_mask);
+}
+
+}  // namespace details
+
+/// @brief Computes the next generation of one bit-packed row.
+///
+/// Each word holds @c Word bits, the least significant bit is the leftmost cell. The cells outside the grid are dead.
+///
+/// @tparam Word Unsigned integer type used to store the cells.
+/// @param above The row above, or @c nullptr if there is none.
+/// @param current The row to update.
+/// @param below The row below, or @c nullptr if there is none.
+/// @param next The output row. Must not alias any of the input rows.
+/// @param words Number of words in a row.
+/// @param last_word_mask Mask of the valid cells in the last word of the row.
+template <typename Word>
+void NextRow(const Word* above, const Word* current, const Word* below, Word* next, std::size_t words,
+             Word last_word_mask) noexcept {
+  static_assert(std::is_unsigned<Word>::value, "Word must be an unsigned integer type");
+
+  // Dispatch once per row, so that the missing rows cost nothing in the loop over the words.
+  if (above != nullptr) {
+    if (below != nullptr) {
+      details::NextRow<true, true>(above, current, below, next, words, last_word_mask);
+    } else {
+      details::NextRow<true, false>(above, current, below, next, words, last_word_mask);
+    }
+  } else if (below != nullptr) {
+    details::NextRow<false, true>(above, current, below, next, words, last_word_mask);
+  } else {
+    details::NextRow<false, false>(above, current, below, next, words, last_word_mask);
+  }
+}
+
+}  // namespace bit_packed
+
+/// @brief Manages the Conway's Game of Life logic on a bit-packed grid.
+///
+/// Unlike @c GameOfLife, every cell takes a single bit, so the grid can be much larger than the display. The next
+/// generation is computed in place, keeping only two rows of the previous generation, which halves the RAM footprint
+/// compared to double buffering.
+///
+/// @tparam Width The width of the game grid.
+/// @tparam Height The height of the game grid.
+template <std::uint16_t Width, std::uint16_t Height>
+class BitPackedGameOfLife {
+ public:
+  /// @brief The width of the game grid.
+  static constexpr std::uint16_t kGridWidth{Width};
+
+  /// @brief The height of the game grid.
+  static constexpr std::uint16_t kGridHeight{Height};
+
+  /// @brief Type of a word holding the cells.
+  using Word = std::uint32_t;
+
+  /// @brief Number of cells in a word.
+  static constexpr std::uint16_t kWordBits{std::numeric_limits<Word>::digits};
+
+  /// @brief Number of words in a row.
+  static constexpr std::uint16_t kRowWords{(kGridWidth + kWordBits - 1U) / kWordBits};
+
+  /// @brief Type of a grid row.
+  using Row = std::array<Word, kRowWords>;
+
+  /// @brief Type of the game grid.
+  using GameBuffer = std::array<Row, kGridHeight>;
+
+  /// @brief Size in cells of the square blocks over which the activity is counted.
+  static constexpr std::uint16_t kBlockSize{64U};
+
+  /// @brief Number of blocks in a row of blocks.
+  static constexpr std::uint16_t kBlockColumns{(kGridWidth + kBlockSize - 1U) / kBlockSize};
+
+  /// @brief Number of rows of blocks.
+  static constexpr std::uint16_t kBlockRows{(kGridHeight + kBlockSize - 1U) / kBlockSize};
+
+  /// @brief Cells of a block that changed during the last update.
+  struct BlockActivity {
+    /// @brief Number of changed cells.
+    std::uint32_t changed_cells{0U};
+    /// @brief X coordinate of the center of the changes, at word granularity. Only valid if @c changed_cells is not
+    /// zero.
+    std::uint16_t center_x{0U};
+    /// @brief Y coordinate of the center of the changes. Only valid if @c changed_cells is not zero.
+    std::uint16_t center_y{0U};
+  };
+
+  /// @brief Cells that changed during the last update.
+  ///
+  /// The changes are counted per block rather than for the whole world, so that separate areas of activity are not
+  /// averaged into the empty space between them.
+  struct Activity {
+    /// @brief Number of changed cells.
+    std::uint32_t changed_cells{0U};
+    /// @brief Activity of every block, indexed by block row then block column.
+    std::array<std::array<BlockActivity, kBlockColumns>, kBlockRows> blocks{};
+  };
+
+  static_assert((kGridWidth > 0U) && (kGridHeight > 0U), "Empty game grid");
+  static_assert(kBlockSize % kWordBits == 0U, "A block must span whole words");
+
+  /// @brief Constructs an empty game grid.
+  BitPackedGameOfLife() noexcept = default;
+
+  /// @brief Constructs a game grid with a random pattern.
+  /// @param seed Seed for the random number generator.
+  explicit BitPackedGameOfLife(std::uint32_t seed) noexcept { InitializeGameGrid(seed); }
+
+  /// @brief Updates the game grid to the next generation.
+  void UpdateGameGrid() noexcept {
+    std::array<std::array<std::uint32_t, kBlockColumns>, kBlockRows> sum_x{};
+    std::array<std::array<std::uint32_t, kBlockColumns>, kBlockRows> sum_y{};
+    activity_ = Activity{};
+
+    for (std::uint16_t coord_y{0U}; coord_y < kGridHeight; ++coord_y) {
+      // `previousRow_` already holds the previous generation of the row above, the row below is not updated yet.
+      currentRow_ = gameGrid_[coord_y];
+      const Word* above{(coord_y > 0U) ? previousRow_.data() : nullptr};
+      const Word* below{(coord_y + 1U < kGridHeight) ? gameGrid_[coord_y + 1U].data() : nullptr};
+      bit_packed::NextRow(above, currentRow_.data(), below, gameGrid_[coord_y].data(), kRowWords, kLastWordMask);
+
+      const std::uint16_t block_row{static_cast<std::uint16_t>(coord_y / kBlockSize)};
+      for (std::uint16_t index{0U}; index < kRowWords; ++index) {
+        const Word changed_cells{gameGrid_[coord_y][index] ^ currentRow_[index]};
+        const auto diff = static_cast<std::uint32_t>(__builtin_popcount(changed_cells));
+        if (diff != 0U) {
+          constexpr std::uint32_t kHalfWord{kWordBits / 2U};
+          const std::uint16_t block_column{static_cast<std::uint16_t>(index / (kBlockSize / kWordBits))};
+          activity_.blocks[block_row][block_column].changed_cells += diff;
+          sum_x[block_row][block_column] += diff * (index * kWordBits + kHalfWord);
+          sum_y[block_row][block_column] += diff * coord_y;
+        }
+      }
+
+      previousRow_ = currentRow_;
+    }
+
+    for (std::uint16_t block_row{0U}; block_row < kBlockRows; ++block_row) {
+      for (std::uint16_t block_column{0U}; block_column < kBlockColumns; ++block_column) {
+        auto& block = activity_.blocks[block_row][block_column];
+        if (block.changed_cells != 0U) {
+          constexpr std::uint16_t kMaxX{kGridWidth - 1U};
+          const std::uint32_t center_x{sum_x[block_row][block_column] / block.changed_cells};
+          block.center_x = static_cast<std::uint16_t>((center_x < kMaxX) ? center_x : kMaxX);
+          block.center_y = static_cast<std::uint16_t>(sum_y[block_row][block_column] / block.changed_cells);
+          activity_.changed_cells += block.changed_cells;
+        }
+      }
+    }
+  }
+
+  /// @brief Checks whether a cell is alive.
+  /// @param coord_x X coordinate of the cell.
+  /// @param coord_y Y coordinate of the cell.
+  /// @return @c true if the cell is alive, @c false otherwise or if the cell is outside the grid.
+  bool IsAlive(std::uint16_t coord_x, std::uint16_t coord_y) const noexcept {
+    if ((coord_x >= kGridWidth) || (coord_y >= kGridHeight)) {
+      return false;
+    }
+    return ((gameGrid_[coord_y][coord_x / kWordBits] >> (coord_x % kWordBits)) & 1U) != 0U;
+  }
+
+  /// @brief Sets the state of a cell. Cells outside the grid are ignored.
+  /// @param coord_x X coordinate of the cell.
+  /// @param coord_y Y coordinate of the cell.
+  /// @param alive @c true for a living cell, @c false otherwise.
+  void SetCell(std::uint16_t coord_x, std::uint16_t coord_y, bool alive) noexcept {
+    if ((coord_x >= kGridWidth) || (coord_y >= kGridHeight)) {
+      return;
+    }
+
+    const Word mask{Word{1U} << (coord_x % kWordBits)};
+    auto& word = gameGrid_[coord_y][coord_x / kWordBits];
+    if (alive) {
+      word |= mask;
+    } else {
+      word &= ~mask;
+    }
+  }
+
+  /// @brief Gets the current game grid.
+  /// @return The game grid.
+  const GameBuffer& GetGameGrid() const noexcept { return gameGrid_; }
+
+  /// @brief Gets the cells that changed during the last update.
+  /// @return The activity of the last update.
+  const Activity& GetActivity() const noexcept { return activity_; }
+
+ private:
+  /// @brief Mask of the valid cells in the last word of a row.
+  static constexpr Word kLastWordMask{(kGridWidth % kWordBits == 0U)
+                                          ? std::numeric_limits<Word>::max()
+                                          : static_cast<Word>((Word{1U} << (kGridWidth % kWordBits)) - 1U)};
+
+  /// @brief Initializes the game grid with a random pattern.
+  /// @param seed Seed for the random number generator.
+  void InitializeGameGrid(std::uint32_t seed) noexcept {
+    std::mt19937 generator(seed);
+
+    for (auto& row : gameGrid_) {
+      for (auto& word : row) {
+        word = static_cast<Word>(generator());
+      }
+      row.back() &= kLastWordMask;
+    }
+  }
+
+  /// @brief Game grid.
+  GameBuffer gameGrid_{};
+
+  /// @brief Previous generation of the row above the one being updated.
+  Row previousRow_{};
+
+  /// @brief Previous generation of the row being updated.
+  Row currentRow_{};
+
+  /// @brief Activity of the last update.
+  Activity activity_{};
+};
+
+#endif  // FIRMWARE_BIT_PACKED_GAME_OF_LIFE_HPP_
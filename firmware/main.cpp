@@ -4,32 +4,17 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "bit_packed_game_of_life.hpp"
 #include "drivers/display/sh_1106.hpp"
-#include "game_of_life.hpp"
 #include "hal/adc.hpp"
 #include "hal/i2c.hpp"
+#include "viewport.hpp"
 
 namespace {
 
 /// @brief Initializes system clock and peripherals.
 void InitializeSystem() { rcc_clock_setup_pll(&rcc_hse_configs[RCC_CLOCK_HSE8_72MHZ]); }
 
-/// @brief Renders the game grid of the Game of Life onto the SH1106 display.
-/// @tparam Width The width of the game grid.
-/// @tparam Height The height of the game grid.
-/// @param game The GameOfLife object containing the grid to render.
-/// @param display The SH1106 display object used for rendering.
-template <std::uint8_t Width, std::uint8_t Height>
-void RenderGameGrid(const GameOfLife<Width, Height>& game, SH1106& display) noexcept {
-  const auto& grid = game.GetGameGrid();
-  for (std::uint8_t coord_y{0U}; coord_y < game.kGridHeight; ++coord_y) {
-    for (std::uint8_t coord_x{0U}; coord_x < game.kGridWidth; ++coord_x) {
-      const bool set{grid[coord_y][coord_x] != 0U};
-      display.SetPixel(coord_x, coord_y, set);
-    }
-  }
-}
-
 /// @brief Returns a random number.
 /// The function uses an ADC to generate a random number. It mixes values from several unconnected ADC channels.
 /// @return A random number.
@@ -54,17 +39,20 @@ int main() {
   hal::I2cBus i2c_bus(hal::I2cBusNumber::kOne);
   SH1106 display(i2c_bus);
 
-  constexpr std::size_t kGameWidth{128U};
-  constexpr std::size_t kGameHeight{64U};
-  static_assert(kGameWidth <= SH1106::kDisplayWidth, "Display width too small");
-  static_assert(kGameHeight <= SH1106::kDisplayHeight, "Display height too small");
+  // The world is larger than the display, only the part inside the viewport is rendered.
+  constexpr std::uint16_t kGameWidth{256U};
+  constexpr std::uint16_t kGameHeight{256U};
+  using Game = BitPackedGameOfLife<kGameWidth, kGameHeight>;
+  using GameViewport = Viewport<Game, SH1106::kDisplayWidth, SH1106::kDisplayHeight>;
 
   const std::uint32_t seed{GetRandomNumber()};
-  GameOfLife<kGameWidth, kGameHeight> game(seed);
+  Game game(seed);
+  GameViewport viewport;
 
   while (true) {
-    RenderGameGrid(game, display);
+    viewport.Render(game, display);
     display.Refresh();
     game.UpdateGameGrid();
+    viewport.Follow(game);
   }
 }
@@ -0,0 +1,156 @@
+#ifndef FIRMWARE_VIEWPORT_HPP_
+#define FIRMWARE_VIEWPORT_HPP_
+
+#include <cstdint>
+
+/// @brief A window onto a game grid that is larger than the display.
+///
+/// Only the cells inside the window are rendered, so the rendering cost depends on the viewport size and not on the
+/// size of the world. The window can follow the activity of the world, panning smoothly towards the busiest block of
+/// cells that changed during the last generation. It keeps following the same block as long as that block is active,
+/// so that it does not jump back and forth between areas of similar activity.
+///
+/// @tparam World The game type, e.g. @c BitPackedGameOfLife.
+/// @tparam Width The width of the viewport.
+/// @tparam Height The height of the viewport.
+template <typename World, std::uint16_t Width, std::uint16_t Height>
+class Viewport {
+ public:
+  /// @brief The width of the viewport.
+  static constexpr std::uint16_t kViewWidth{Width};
+
+  /// @brief The height of the viewport.
+  static constexpr std::uint16_t kViewHeight{Height};
+
+  /// @brief Maximum distance in cells the viewport moves per @c Follow call.
+  static constexpr std::uint16_t kMaxPanStep{2U};
+
+  static_assert(kViewWidth <= World::kGridWidth, "Viewport wider than the world");
+  static_assert(kViewHeight <= World::kGridHeight, "Viewport higher than the world");
+
+  /// @brief Constructs a viewport centered on the world.
+  Viewport() noexcept { CenterOn(World::kGridWidth / 2U, World::kGridHeight / 2U); }
+
+  /// @brief Moves the top-left corner of the viewport. The position is clamped to the world.
+  /// @param coord_x X coordinate of the top-left corner.
+  /// @param coord_y Y coordinate of the top-left corner.
+  void MoveTo(std::uint16_t coord_x, std::uint16_t coord_y) noexcept {
+    originX_ = Clamp(coord_x, kMaxOriginX);
+    originY_ = Clamp(coord_y, kMaxOriginY);
+    FollowCenterBlock();
+  }
+
+  /// @brief Centers the viewport on a world cell. The position is clamped to the world.
+  /// @param coord_x X coordinate of the cell.
+  /// @param coord_y Y coordinate of the cell.
+  void CenterOn(std::uint16_t coord_x, std::uint16_t coord_y) noexcept {
+    originX_ = TargetOrigin(coord_x, kViewWidth, kMaxOriginX);
+    originY_ = TargetOrigin(coord_y, kViewHeight, kMaxOriginY);
+    FollowCenterBlock();
+  }
+
+  /// @brief Pans the viewport towards the activity of the last generation.
+  ///
+  /// The viewport keeps following its current block while it is active, otherwise it switches to the busiest block.
+  /// It stays in place if nothing changed.
+  ///
+  /// @param world The world to follow.
+  void Follow(const World& world) noexcept {
+    const auto& activity = world.GetActivity();
+    if (activity.changed_cells == 0U) {
+      return;
+    }
+
+    if (activity.blocks[blockRow_][blockColumn_].changed_cells == 0U) {
+      std::uint32_t busiest{0U};
+      for (std::uint16_t block_row{0U}; block_row < World::kBlockRows; ++block_row) {
+        for (std::uint16_t block_column{0U}; block_column < World::kBlockColumns; ++block_column) {
+          const std::uint32_t changed{activity.blocks[block_row][block_column].changed_cells};
+          if (changed > busiest) {
+            busiest = changed;
+            blockRow_ = block_row;
+            blockColumn_ = block_column;
+          }
+        }
+      }
+    }
+
+    const auto& block = activity.blocks[blockRow_][blockColumn_];
+    originX_ = Approach(originX_, TargetOrigin(block.center_x, kViewWidth, kMaxOriginX));
+    originY_ = Approach(originY_, TargetOrigin(block.center_y, kViewHeight, kMaxOriginY));
+  }
+
+  /// @brief Renders the visible part of the world onto a display.
+  /// @tparam Display The display type. It should provide @c SetPixel(x, y, set), e.g. @c SH1106.
+  /// @param world The world to render.
+  /// @param display The display used for rendering.
+  template <typename Display>
+  void Render(const World& world, Display& display) const noexcept {
+    for (std::uint16_t coord_y{0U}; coord_y < kViewHeight; ++coord_y) {
+      for (std::uint16_t coord_x{0U}; coord_x < kViewWidth; ++coord_x) {
+        const bool set{world.IsAlive(originX_ + coord_x, originY_ + coord_y)};
+        display.SetPixel(coord_x, coord_y, set);
+      }
+    }
+  }
+
+  /// @brief Gets the X coordinate of the top-left corner.
+  std::uint16_t GetOriginX() const noexcept { return originX_; }
+
+  /// @brief Gets the Y coordinate of the top-left corner.
+  std::uint16_t GetOriginY() const noexcept { return originY_; }
+
+ private:
+  /// @brief Maximum X coordinate of the top-left corner.
+  static constexpr std::uint16_t kMaxOriginX{World::kGridWidth - kViewWidth};
+
+  /// @brief Maximum Y coordinate of the top-left corner.
+  static constexpr std::uint16_t kMaxOriginY{World::kGridHeight - kViewHeight};
+
+  /// @brief Clamps a coordinate to the given maximum.
+  static std::uint16_t Clamp(std::uint16_t value, std::uint16_t max_value) noexcept {
+    return (value < max_value) ? value : max_value;
+  }
+
+  /// @brief Computes the origin that centers the viewport on a coordinate.
+  /// @param center The coordinate to center on.
+  /// @param size The size of the viewport along the axis.
+  /// @param max_origin The maximum origin along the axis.
+  /// @return The clamped origin.
+  static std::uint16_t TargetOrigin(std::uint16_t center, std::uint16_t size, std::uint16_t max_origin) noexcept {
+    const std::uint16_t half{static_cast<std::uint16_t>(size / 2U)};
+    const std::uint16_t origin{static_cast<std::uint16_t>((center > half) ? (center - half) : 0U)};
+    return Clamp(origin, max_origin);
+  }
+
+  /// @brief Follows the block under the center of the viewport.
+  void FollowCenterBlock() noexcept {
+    blockColumn_ = static_cast<std::uint16_t>((originX_ + kViewWidth / 2U) / World::kBlockSize);
+    blockRow_ = static_cast<std::uint16_t>((originY_ + kViewHeight / 2U) / World::kBlockSize);
+  }
+
+  /// @brief Moves a coordinate towards a target by at most @c kMaxPanStep.
+  static std::uint16_t Approach(std::uint16_t value, std::uint16_t target) noexcept {
+    if (value + kMaxPanStep < target) {
+      return static_cast<std::uint16_t>(value + kMaxPanStep);
+    }
+    if (target + kMaxPanStep < value) {
+      return static_cast<std::uint16_t>(value - kMaxPanStep);
+    }
+    return target;
+  }
+
+  /// @brief X coordinate of the top-left corner.
+  std::uint16_t originX_{0U};
+
+  /// @brief Y coordinate of the top-left corner.
+  std::uint16_t originY_{0U};
+
+  /// @brief Column of the block being followed.
+  std::uint16_t blockColumn_{0U};
+
+  /// @brief Row of the block being followed.
+  std::uint16_t blockRow_{0U};
+};
+
+#endif  // FIRMWARE_VIEWPORT_HPP_
@@ -0,0 +1,139 @@
+#ifndef HOST_BIT_GRID_HPP_
+#define HOST_BIT_GRID_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "bit_packed_game_of_life.hpp"
+
+namespace host {
+
+/// @brief Bit-packed game grid with a size chosen at run time.
+///
+/// The host counterpart of @c BitPackedGameOfLife for boards that are too large for a @c std::array. Every row starts
+/// at a word boundary, the least significant bit of a word is the leftmost cell.
+class BitGrid {
+ public:
+  /// @brief Type of a word holding the cells.
+  using Word = std::uint64_t;
+
+  /// @brief Number of cells in a word.
+  static constexpr std::size_t kWordBits{std::numeric_limits<Word>::digits};
+
+  /// @brief Constructs an empty grid.
+  /// @param width The width of the grid.
+  /// @param height The height of the grid.
+  BitGrid(std::size_t width, std::size_t height)
+      : width_{width}, height_{height}, rowWords_{WordsPerRow(width)}, words_(rowWords_ * height, 0U) {}
+
+  /// @brief Gets the number of words needed for a row of the given width.
+  static constexpr std::size_t WordsPerRow(std::size_t width) noexcept { return (width + kWordBits - 1U) / kWordBits; }
+
+  /// @brief Gets the mask of the valid cells in the last word of a row of the given width.
+  static constexpr Word LastWordMask(std::size_t width) noexcept {
+    return (width % kWordBits == 0U) ? std::numeric_limits<Word>::max() : (Word{1U} << (width % kWordBits)) - 1U;
+  }
+
+  /// @brief Gets the width of the grid.
+  std::size_t GetWidth() const noexcept { return width_; }
+
+  /// @brief Gets the height of the grid.
+  std::size_t GetHeight() const noexcept { return height_; }
+
+  /// @brief Gets the number of words in a row.
+  std::size_t GetRowWords() const noexcept { return rowWords_; }
+
+  /// @brief Gets a row of the grid.
+  /// @param coord_y Y coordinate of the row.
+  /// @{
+  Word* Row(std::size_t coord_y) noexcept { return &words_[coord_y * rowWords_]; }
+  const Word* Row(std::size_t coord_y) const noexcept { return &words_[coord_y * rowWords_]; }
+  /// @}
+
+  /// @brief Checks whether a cell is alive.
+  /// @param coord_x X coordinate of the cell.
+  /// @param coord_y Y coordinate of the cell.
+  /// @return @c true if the cell is alive, @c false otherwise or if the cell is outside the grid.
+  bool IsAlive(std::size_t coord_x, std::size_t coord_y) const noexcept {
+    if ((coord_x >= width_) || (coord_y >= height_)) {
+      return false;
+    }
+    return ((Row(coord_y)[coord_x / kWordBits] >> (coord_x % kWordBits)) & 1U) != 0U;
+  }
+
+  /// @brief Sets the state of a cell. Cells outside the grid are ignored.
+  /// @param coord_x X coordinate of the cell.
+  /// @param coord_y Y coordinate of the cell.
+  /// @param alive @c true for a living cell, @c false otherwise.
+  void SetCell(std::size_t coord_x, std::size_t coord_y, bool alive) noexcept {
+    if ((coord_x >= width_) || (coord_y >= height_)) {
+      return;
+    }
+
+    const Word mask{Word{1U} << (coord_x % kWordBits)};
+    auto& word = Row(coord_y)[coord_x / kWordBits];
+    if (alive) {
+      word |= mask;
+    } else {
+      word &= ~mask;
+    }
+  }
+
+  /// @brief Fills the grid with a random pattern.
+  /// @param seed Seed for the random number generator.
+  void Randomize(std::uint32_t seed) noexcept {
+    std::mt19937_64 generator(seed);
+    const Word last_word_mask{LastWordMask(width_)};
+
+    for (std::size_t coord_y{0U}; coord_y < height_; ++coord_y) {
+      Word* row{Row(coord_y)};
+      for (std::size_t index{0U}; index < rowWords_; ++index) {
+        row[index] = generator();
+      }
+      row[rowWords_ - 1U] &= last_word_mask;
+    }
+  }
+
+  /// @brief Compares the cells of two grids.
+  bool operator==(const BitGrid& other) const noexcept {
+    return (width_ == other.width_) && (height_ == other.height_) && (words_ == other.words_);
+  }
+
+  /// @brief Compares the cells of two grids.
+  bool operator!=(const BitGrid& other) const noexcept { return !(*this == other); }
+
+ private:
+  /// @brief The width of the grid.
+  std::size_t width_;
+
+  /// @brief The height of the grid.
+  std::size_t height_;
+
+  /// @brief Number of words in a row.
+  std::size_t rowWords_;
+
+  /// @brief The cells, row by row.
+  std::vector<Word> words_;
+};
+
+/// @brief Computes the next generation of a whole grid in a single streaming pass.
+/// @param current The current generation.
+/// @param next The next generation. Must have the same size as @p current.
+inline void StepGeneration(const BitGrid& current, BitGrid& next) noexcept {
+  const std::size_t height{current.GetHeight()};
+  const std::size_t words{current.GetRowWords()};
+  const BitGrid::Word last_word_mask{BitGrid::LastWordMask(current.GetWidth())};
+
+  for (std::size_t coord_y{0U}; coord_y < height; ++coord_y) {
+    const BitGrid::Word* above{(coord_y > 0U) ? current.Row(coord_y - 1U) : nullptr};
+    const BitGrid::Word* below{(coord_y + 1U < height) ? current.Row(coord_y + 1U) : nullptr};
+    bit_packed::NextRow(above, current.Row(coord_y), below, next.Row(coord_y), words, last_word_mask);
+  }
+}
+
+}  // namespace host
+
+#endif  // HOST_BIT_GRID_HPP_
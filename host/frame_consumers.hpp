@@ -0,0 +1,198 @@
+#ifndef HOST_FRAME_CONSUMERS_HPP_
+#define HOST_FRAME_CONSUMERS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "bit_grid.hpp"
+
+namespace host {
+namespace details {
+
+/// @brief Number of pixels in a byte.
+constexpr std::size_t kBitsPerByte{8U};
+
+/// @brief Accessors for the supported frame types.
+/// @{
+template <typename Cell, std::size_t Width, std::size_t Height>
+std::size_t FrameWidth(const std::array<std::array<Cell, Width>, Height>& /*frame*/) noexcept {
+  return Width;
+}
+
+template <typename Cell, std::size_t Width, std::size_t Height>
+std::size_t FrameHeight(const std::array<std::array<Cell, Width>, Height>& /*frame*/) noexcept {
+  return Height;
+}
+
+inline std::size_t FrameWidth(const BitGrid& frame) noexcept { return frame.GetWidth(); }
+
+inline std::size_t FrameHeight(const BitGrid& frame) noexcept { return frame.GetHeight(); }
+/// @}
+
+/// @brief Counts the living cells of a frame.
+/// @{
+template <typename Cell, std::size_t Width, std::size_t Height>
+std::uint64_t Population(const std::array<std::array<Cell, Width>, Height>& frame) noexcept {
+  std::uint64_t population{0U};
+  for (const auto& row : frame) {
+    for (const auto cell : row) {
+      population += (cell != 0U) ? 1U : 0U;
+    }
+  }
+  return population;
+}
+
+inline std::uint64_t Population(const BitGrid& frame) noexcept {
+  std::uint64_t population{0U};
+  for (std::size_t coord_y{0U}; coord_y < frame.GetHeight(); ++coord_y) {
+    const BitGrid::Word* row{frame.Row(coord_y)};
+    for (std::size_t index{0U}; index < frame.GetRowWords(); ++index) {
+      population += static_cast<std::uint64_t>(__builtin_popcountll(row[index]));
+    }
+  }
+  return population;
+}
+/// @}
+
+/// @brief Builds a table mapping every byte to the byte with its bits in reverse order.
+constexpr std::array<std::uint8_t, 256> MakeReversedBits() noexcept {
+  std::array<std::uint8_t, 256> table{};
+  for (std::size_t byte{0U}; byte < table.size(); ++byte) {
+    for (std::size_t bit{0U}; bit < kBitsPerByte; ++bit) {
+      table[byte] |= static_cast<std::uint8_t>(((byte >> bit) & 1U) << (kBitsPerByte - 1U - bit));
+    }
+  }
+  return table;
+}
+
+/// @brief Every byte with its bits in reverse order.
+constexpr std::array<std::uint8_t, 256> kReversedBits{MakeReversedBits()};
+
+/// @brief Packs a row of a frame into PBM bytes: the most significant bit is the leftmost pixel.
+/// @param frame The frame.
+/// @param coord_y Y coordinate of the row.
+/// @param bytes The output, @c (width + 7) / 8 bytes.
+/// @{
+template <typename Cell, std::size_t Width, std::size_t Height>
+void PackRow(const std::array<std::array<Cell, Width>, Height>& frame, std::size_t coord_y, char* bytes) noexcept {
+  std::fill(bytes, bytes + (Width + kBitsPerByte - 1U) / kBitsPerByte, 0);
+  for (std::size_t coord_x{0U}; coord_x < Width; ++coord_x) {
+    if (frame[coord_y][coord_x] != 0U) {
+      bytes[coord_x / kBitsPerByte] |= static_cast<char>(0x80U >> (coord_x % kBitsPerByte));
+    }
+  }
+}
+
+inline void PackRow(const BitGrid& frame, std::size_t coord_y, char* bytes) noexcept {
+  // The grid stores the leftmost cell in the least significant bit of a little-endian word, so the PBM bytes are the
+  // bytes of the words with their bits reversed.
+  const BitGrid::Word* row{frame.Row(coord_y)};
+  const std::size_t row_bytes{(frame.GetWidth() + kBitsPerByte - 1U) / kBitsPerByte};
+  for (std::size_t index{0U}; index < row_bytes; ++index) {
+    const auto byte = static_cast<std::uint8_t>(row[index / sizeof(BitGrid::Word)] >>
+                                                ((index % sizeof(BitGrid::Word)) * kBitsPerByte));
+    bytes[index] = static_cast<char>(kReversedBits[byte]);
+  }
+}
+/// @}
+
+}  // namespace details
+
+/// @brief Writes every frame as a binary PBM (P4) image to a stream.
+///
+/// The images are concatenated, which is a valid multi-image PBM stream.
+///
+/// @tparam Frame The frame type, @c GameOfLife::GameBuffer or @c BitGrid.
+template <typename Frame>
+class PbmWriter {
+ public:
+  /// @brief Constructs a writer.
+  /// @param stream The output stream. Must outlive the writer.
+  /// @param prototype A frame of the size that will be written, used to preallocate the row buffer.
+  PbmWriter(std::ostream& stream, const Frame& prototype)
+      : stream_{&stream},
+        row_((details::FrameWidth(prototype) + details::kBitsPerByte - 1U) / details::kBitsPerByte) {}
+
+  /// @brief Writes a frame.
+  /// @param generation The generation of the frame, unused.
+  /// @param frame The frame.
+  void operator()(std::uint64_t /*generation*/, const Frame& frame) {
+    const std::size_t width{details::FrameWidth(frame)};
+    const std::size_t height{details::FrameHeight(frame)};
+    *stream_ << "P4\n" << width << ' ' << height << '\n';
+
+    // PBM rows are padded to whole bytes and 1 is black (alive).
+    for (std::size_t coord_y{0U}; coord_y < height; ++coord_y) {
+      details::PackRow(frame, coord_y, row_.data());
+      stream_->write(row_.data(), static_cast<std::streamsize>(row_.size()));
+    }
+  }
+
+ private:
+  /// @brief The output stream.
+  std::ostream* stream_;
+
+  /// @brief Buffer holding one packed row.
+  std::vector<char> row_;
+};
+
+/// @brief Collects the population of every frame.
+///
+/// Pass it to a stage with @c std::ref to read the statistics after the stage is stopped.
+///
+/// @tparam Frame The frame type, @c GameOfLife::GameBuffer or @c BitGrid.
+template <typename Frame>
+class PopulationStats {
+ public:
+  /// @brief Counts the living cells of a frame.
+  /// @param generation The generation of the frame.
+  /// @param frame The frame.
+  void operator()(std::uint64_t generation, const Frame& frame) noexcept {
+    const std::uint64_t population{details::Population(frame)};
+
+    lastGeneration_ = generation;
+    lastPopulation_ = population;
+    minPopulation_ = (frames_ == 0U) ? population : std::min(minPopulation_, population);
+    maxPopulation_ = std::max(maxPopulation_, population);
+    ++frames_;
+  }
+
+  /// @brief Gets the number of frames seen.
+  std::uint64_t GetFrames() const noexcept { return frames_; }
+
+  /// @brief Gets the generation of the last frame.
+  std::uint64_t GetLastGeneration() const noexcept { return lastGeneration_; }
+
+  /// @brief Gets the population of the last frame.
+  std::uint64_t GetLastPopulation() const noexcept { return lastPopulation_; }
+
+  /// @brief Gets the smallest population seen.
+  std::uint64_t GetMinPopulation() const noexcept { return minPopulation_; }
+
+  /// @brief Gets the largest population seen.
+  std::uint64_t GetMaxPopulation() const noexcept { return maxPopulation_; }
+
+ private:
+  /// @brief Number of frames seen.
+  std::uint64_t frames_{0U};
+
+  /// @brief Generation of the last frame.
+  std::uint64_t lastGeneration_{0U};
+
+  /// @brief Population of the last frame.
+  std::uint64_t lastPopulation_{0U};
+
+  /// @brief Smallest population seen.
+  std::uint64_t minPopulation_{0U};
+
+  /// @brief Largest population seen.
+  std::uint64_t maxPopulation_{0U};
+};
+
+}  // namespace host
+
+#endif  // HOST_FRAME_CONSUMERS_HPP_
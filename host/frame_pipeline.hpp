@@ -0,0 +1,164 @@
+#ifndef HOST_FRAME_PIPELINE_HPP_
+#define HOST_FRAME_PIPELINE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "snapshot_ring.hpp"
+
+namespace host {
+
+/// @brief An output stage: a reader of a snapshot ring drained by a consumer running on its own thread.
+/// @tparam Frame The snapshot type.
+template <typename Frame>
+class OutputStage {
+ public:
+  /// @brief Callable receiving the generation and the frame.
+  using Consumer = std::function<void(std::uint64_t generation, const Frame& frame)>;
+
+  /// @brief Constructs a stage reading a ring and starts its thread. Must be called from the producer thread.
+  /// @param ring The ring. Must outlive the stage.
+  /// @param policy What to do when the ring is full for this stage.
+  /// @param consumer The consumer. Use @c std::ref to keep access to a stateful consumer.
+  OutputStage(SnapshotRing<Frame>& ring, BackpressurePolicy policy, Consumer consumer)
+      : ring_{&ring}, reader_{&ring.AddReader(policy)}, consumer_{std::move(consumer)}, thread_{[this]() { Run(); }} {}
+
+  /// @brief Stops the stage after the queued frames are consumed.
+  ~OutputStage() { Stop(); }
+
+  /// @brief Deleted copy and move constructors and assignment operators.
+  /// @{
+  OutputStage(const OutputStage&) = delete;
+  OutputStage(OutputStage&&) = delete;
+  OutputStage& operator=(const OutputStage&) = delete;
+  OutputStage& operator=(OutputStage&&) = delete;
+  /// @}
+
+  /// @brief Consumes the queued frames, stops the thread and detaches the stage from the ring, so that the producer
+  /// never waits for it anymore. Must be called from the producer thread.
+  void Stop() {
+    stopping_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+      thread_.join();
+      ring_->RemoveReader(*reader_);
+    }
+  }
+
+  /// @brief Gets the number of discarded frames.
+  std::uint64_t GetDropped() const noexcept { return reader_->GetDropped(); }
+
+ private:
+  /// @brief Consumes frames until the stage is stopped and the ring is empty.
+  void Run() {
+    std::uint32_t idle_rounds{0U};
+    while (true) {
+      if (ring_->TryConsume(*reader_, consumer_)) {
+        idle_rounds = 0U;
+        continue;
+      }
+
+      // Stopping is checked before emptiness, so a frame published before Stop() is always consumed.
+      if (stopping_.load(std::memory_order_acquire) && ring_->IsEmpty(*reader_)) {
+        return;
+      }
+
+      // Spin briefly for the next frame, then back off to leave the core to the simulation.
+      constexpr std::uint32_t kSpinRounds{64U};
+      constexpr std::chrono::microseconds kIdleSleep{50};
+      if (++idle_rounds < kSpinRounds) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(kIdleSleep);
+      }
+    }
+  }
+
+  /// @brief The ring holding the queued frames.
+  SnapshotRing<Frame>* ring_;
+
+  /// @brief Read position of the stage in the ring.
+  typename SnapshotRing<Frame>::Reader* reader_;
+
+  /// @brief The consumer.
+  Consumer consumer_;
+
+  /// @brief Set when the stage should stop once the ring is empty.
+  std::atomic<bool> stopping_{false};
+
+  /// @brief The consumer thread. Declared last, so that it starts after the other members are initialized.
+  std::thread thread_;
+};
+
+/// @brief Fans out the generations of a simulation to output stages running on their own threads.
+///
+/// The simulation thread calls @c Publish after each generation, which copies the frame once into a preallocated ring
+/// shared by all the stages. Each stage reads the ring at its own pace, so a slow consumer only affects its own stage,
+/// according to its backpressure policy, unless a @c BackpressurePolicy::kBlock stage fills the ring.
+///
+/// @tparam Frame The snapshot type, e.g. @c GameOfLife::GameBuffer or @c BitGrid.
+template <typename Frame>
+class FramePipeline {
+ public:
+  /// @brief Constructs a pipeline without stages.
+  /// @param capacity Number of slots in the ring.
+  /// @param prototype Frame used to preallocate the slots.
+  FramePipeline(std::size_t capacity, const Frame& prototype) : ring_{capacity, prototype} {}
+
+  /// @brief Stops the stages before the ring they read is destroyed.
+  ~FramePipeline() { Stop(); }
+
+  /// @brief Deleted copy and move constructors and assignment operators.
+  /// @{
+  FramePipeline(const FramePipeline&) = delete;
+  FramePipeline(FramePipeline&&) = delete;
+  FramePipeline& operator=(const FramePipeline&) = delete;
+  FramePipeline& operator=(FramePipeline&&) = delete;
+  /// @}
+
+  /// @brief Adds a stage. The stage receives the generations published after it is added.
+  /// @param policy What to do when the ring is full for this stage.
+  /// @param consumer The consumer.
+  /// @return The stage.
+  OutputStage<Frame>& AddStage(BackpressurePolicy policy, typename OutputStage<Frame>::Consumer consumer) {
+    stages_.push_back(std::make_unique<OutputStage<Frame>>(ring_, policy, std::move(consumer)));
+    return *stages_.back();
+  }
+
+  /// @brief Publishes a generation to all the stages. Does nothing once the pipeline is stopped.
+  /// @param generation The generation of the frame.
+  /// @param frame The frame.
+  void Publish(std::uint64_t generation, const Frame& frame) {
+    if (!stopped_) {
+      ring_.Publish(generation, frame);
+    }
+  }
+
+  /// @brief Consumes the queued frames and stops all the stages.
+  void Stop() {
+    stopped_ = true;
+    for (auto& stage : stages_) {
+      stage->Stop();
+    }
+  }
+
+ private:
+  /// @brief The frames shared by the stages. Declared first, so that it is destroyed after the stages.
+  SnapshotRing<Frame> ring_;
+
+  /// @brief The stages.
+  std::vector<std::unique_ptr<OutputStage<Frame>>> stages_;
+
+  /// @brief Set once the pipeline is stopped.
+  bool stopped_{false};
+};
+
+}  // namespace host
+
+#endif  // HOST_FRAME_PIPELINE_HPP_
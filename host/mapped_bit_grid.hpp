@@ -0,0 +1,415 @@
+#ifndef HOST_MAPPED_BIT_GRID_HPP_
+#define HOST_MAPPED_BIT_GRID_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "bit_grid.hpp"
+
+namespace host {
+
+/// @brief Bit-packed game grid stored in a memory-mapped file.
+///
+/// The layout of the cells is the same as in @c BitGrid, so the grid can be larger than the physical memory. The file
+/// starts with a small header holding the size of the grid, followed by the rows.
+///
+/// Only the rows that are touched are paged in. Callers streaming through the grid should use @c WillNeed and
+/// @c Release to keep the resident set bounded.
+class MappedBitGrid {
+ public:
+  /// @brief Type of a word holding the cells.
+  using Word = BitGrid::Word;
+
+  /// @brief Creates a file holding an empty grid. An existing file is overwritten.
+  /// @param path Path of the file.
+  /// @param width The width of the grid.
+  /// @param height The height of the grid.
+  /// @return The grid, or @c std::nullopt if the file could not be created or mapped.
+  static std::optional<MappedBitGrid> Create(const std::string& path, std::size_t width, std::size_t height) {
+    if (!IsValidSize(width, height)) {
+      return std::nullopt;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    const int file{::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+    if (file < 0) {
+      return std::nullopt;
+    }
+
+    // Reserve the blocks now, so running out of disk space is reported here instead of as SIGBUS on a later write.
+    const auto file_size = static_cast<off_t>(FileSize(width, height));
+    if (::posix_fallocate(file, 0, file_size) != 0) {
+      ::close(file);
+      return std::nullopt;
+    }
+
+    auto grid = Map(path, file, width, height);
+    if (grid) {
+      const FileHeader header{kMagic, width, height};
+      std::memcpy(grid->mapping_, &header, sizeof(header));
+    }
+    return grid;
+  }
+
+  /// @brief Opens a file holding a grid.
+  /// @param path Path of the file.
+  /// @return The grid, or @c std::nullopt if the file could not be opened or is not a grid.
+  static std::optional<MappedBitGrid> Open(const std::string& path) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    const int file{::open(path.c_str(), O_RDWR)};
+    if (file < 0) {
+      return std::nullopt;
+    }
+
+    FileHeader header{};
+    const bool valid{(::pread(file, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header))) &&
+                     (header.magic == kMagic) && IsValidSize(header.width, header.height) &&
+                     (::lseek(file, 0, SEEK_END) == static_cast<off_t>(FileSize(header.width, header.height)))};
+    if (!valid) {
+      ::close(file);
+      return std::nullopt;
+    }
+
+    return Map(path, file, header.width, header.height);
+  }
+
+  /// @brief Unmaps and closes the file.
+  ~MappedBitGrid() { Close(); }
+
+  /// @brief Deleted copy constructor and assignment operator.
+  /// @{
+  MappedBitGrid(const MappedBitGrid&) = delete;
+  MappedBitGrid& operator=(const MappedBitGrid&) = delete;
+  /// @}
+
+  /// @brief Move constructor and assignment operator. The moved-from object no longer owns the file.
+  /// @{
+  MappedBitGrid(MappedBitGrid&& other) noexcept
+      : path_{std::move(other.path_)},
+        file_{std::exchange(other.file_, -1)},
+        mapping_{std::exchange(other.mapping_, nullptr)},
+        mappingSize_{std::exchange(other.mappingSize_, 0U)},
+        width_{other.width_},
+        height_{other.height_},
+        rowWords_{other.rowWords_} {}
+
+  MappedBitGrid& operator=(MappedBitGrid&& other) noexcept {
+    if (this != &other) {
+      Close();
+      path_ = std::move(other.path_);
+      file_ = std::exchange(other.file_, -1);
+      mapping_ = std::exchange(other.mapping_, nullptr);
+      mappingSize_ = std::exchange(other.mappingSize_, 0U);
+      width_ = other.width_;
+      height_ = other.height_;
+      rowWords_ = other.rowWords_;
+    }
+    return *this;
+  }
+  /// @}
+
+  /// @brief Gets the path of the file.
+  const std::string& GetPath() const noexcept { return path_; }
+
+  /// @brief Checks whether a path refers to the file holding this grid, under any name.
+  /// @param path The path to check.
+  /// @return @c true if the path is the file of this grid, @c false otherwise or if it does not exist.
+  bool IsBackedBy(const std::string& path) const noexcept {
+    struct stat mapped_file {};
+    struct stat other_file {};
+    return (::fstat(file_, &mapped_file) == 0) && (::stat(path.c_str(), &other_file) == 0) &&
+           (mapped_file.st_dev == other_file.st_dev) && (mapped_file.st_ino == other_file.st_ino);
+  }
+
+  /// @brief Gets the width of the grid.
+  std::size_t GetWidth() const noexcept { return width_; }
+
+  /// @brief Gets the height of the grid.
+  std::size_t GetHeight() const noexcept { return height_; }
+
+  /// @brief Gets the number of words in a row.
+  std::size_t GetRowWords() const noexcept { return rowWords_; }
+
+  /// @brief Gets a row of the grid.
+  /// @param coord_y Y coordinate of the row.
+  /// @{
+  Word* Row(std::size_t coord_y) noexcept { return Data() + coord_y * rowWords_; }
+  const Word* Row(std::size_t coord_y) const noexcept { return Data() + coord_y * rowWords_; }
+  /// @}
+
+  /// @brief Checks whether a cell is alive.
+  /// @param coord_x X coordinate of the cell.
+  /// @param coord_y Y coordinate of the cell.
+  /// @return @c true if the cell is alive, @c false otherwise or if the cell is outside the grid.
+  bool IsAlive(std::size_t coord_x, std::size_t coord_y) const noexcept {
+    if ((coord_x >= width_) || (coord_y >= height_)) {
+      return false;
+    }
+    return ((Row(coord_y)[coord_x / BitGrid::kWordBits] >> (coord_x % BitGrid::kWordBits)) & 1U) != 0U;
+  }
+
+  /// @brief Sets the state of a cell. Cells outside the grid are ignored.
+  /// @param coord_x X coordinate of the cell.
+  /// @param coord_y Y coordinate of the cell.
+  /// @param alive @c true for a living cell, @c false otherwise.
+  void SetCell(std::size_t coord_x, std::size_t coord_y, bool alive) noexcept {
+    if ((coord_x >= width_) || (coord_y >= height_)) {
+      return;
+    }
+
+    const Word mask{Word{1U} << (coord_x % BitGrid::kWordBits)};
+    auto& word = Row(coord_y)[coord_x / BitGrid::kWordBits];
+    if (alive) {
+      word |= mask;
+    } else {
+      word &= ~mask;
+    }
+  }
+
+  /// @brief Fills the grid with a random pattern.
+  ///
+  /// The rows are written sequentially and released in bands, so the grid may be larger than the physical memory.
+  ///
+  /// @param seed Seed for the random number generator.
+  /// @param band_rows Number of rows written before they are released.
+  void Randomize(std::uint32_t seed, std::size_t band_rows) noexcept {
+    std::mt19937_64 generator(seed);
+    const Word last_word_mask{BitGrid::LastWordMask(width_)};
+
+    for (std::size_t coord_y{0U}; coord_y < height_; ++coord_y) {
+      Word* row{Row(coord_y)};
+      for (std::size_t index{0U}; index < rowWords_; ++index) {
+        row[index] = generator();
+      }
+      row[rowWords_ - 1U] &= last_word_mask;
+
+      if ((band_rows != 0U) && ((coord_y + 1U) % band_rows == 0U)) {
+        Flush(coord_y + 1U - band_rows, coord_y + 1U);
+        Release(coord_y + 1U - band_rows, coord_y + 1U);
+      }
+    }
+    Release(0U, height_);
+  }
+
+  /// @brief Hints the kernel that a range of rows will be read soon.
+  /// @param first_row The first row of the range.
+  /// @param end_row The row past the end of the range.
+  void WillNeed(std::size_t first_row, std::size_t end_row) const noexcept {
+    Advise(first_row, end_row, MADV_WILLNEED, false);
+  }
+
+  /// @brief Drops a range of rows from the resident set. Modified rows are kept in the page cache until written back.
+  /// @param first_row The first row of the range.
+  /// @param end_row The row past the end of the range.
+  void Release(std::size_t first_row, std::size_t end_row) const noexcept {
+    Advise(first_row, end_row, MADV_DONTNEED, true);
+  }
+
+  /// @brief Starts writing a range of rows back to the file without waiting for completion.
+  ///
+  /// Uses @c sync_file_range, since @c msync with @c MS_ASYNC does not start any I/O on Linux. Writing back each band
+  /// as soon as it is complete keeps the dirty pages from piling up until the kernel throttles the writer.
+  ///
+  /// @param first_row The first row of the range.
+  /// @param end_row The row past the end of the range.
+  void Flush(std::size_t first_row, std::size_t end_row) const noexcept {
+    std::size_t begin{0U};
+    std::size_t end{0U};
+    if (PageRange(first_row, end_row, false, begin, end)) {
+      ::sync_file_range(file_, static_cast<off_t>(begin), static_cast<off_t>(end - begin), SYNC_FILE_RANGE_WRITE);
+    }
+  }
+
+  /// @brief Overwrites a range of rows through the file rather than through the mapping.
+  ///
+  /// The first store through the mapping to a page that is not resident reads the page from the file, even if the whole
+  /// page is about to be overwritten. Writing through the file only reads the partial pages at both ends of the range.
+  ///
+  /// @param first_row The first row to overwrite.
+  /// @param rows The new rows, @c GetRowWords words each.
+  /// @param row_count Number of rows. The rows past the end of the grid are ignored.
+  /// @return @c true on success, @c false otherwise.
+  bool WriteRows(std::size_t first_row, const Word* rows, std::size_t row_count) const noexcept {
+    row_count = (first_row < height_) ? std::min(row_count, height_ - first_row) : 0U;
+    const auto* data = static_cast<const std::uint8_t*>(static_cast<const void*>(rows));
+    std::size_t remaining{row_count * rowWords_ * sizeof(Word)};
+    auto offset = static_cast<off_t>(kDataOffset + first_row * rowWords_ * sizeof(Word));
+    while (remaining > 0U) {
+      const ssize_t written{::pwrite(file_, data, remaining, offset)};
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data += written;
+      remaining -= static_cast<std::size_t>(written);
+      offset += written;
+    }
+    return true;
+  }
+
+  /// @brief Writes the whole grid back to the file and waits for completion.
+  /// @return @c true on success, @c false otherwise.
+  bool Sync() const noexcept { return ::msync(mapping_, mappingSize_, MS_SYNC) == 0; }
+
+ private:
+  /// @brief Header at the start of the file.
+  struct FileHeader {
+    /// @brief Identifies the file format.
+    std::uint64_t magic;
+    /// @brief The width of the grid.
+    std::uint64_t width;
+    /// @brief The height of the grid.
+    std::uint64_t height;
+  };
+
+  /// @brief The value of @c FileHeader::magic ("LIFEGRID").
+  static constexpr std::uint64_t kMagic{0x444952474546494CU};
+
+  /// @brief Offset of the first row in the file. Keeps the rows aligned to a cache line.
+  static constexpr std::size_t kDataOffset{64U};
+
+  static_assert(sizeof(FileHeader) <= kDataOffset, "File header too large");
+
+  /// @brief Checks that a grid is not empty and that the size of its file fits in @c std::size_t and @c off_t.
+  ///
+  /// The size read from the header of a file is untrusted: without this check, a huge width makes @c FileSize wrap
+  /// around and match a small file.
+  static bool IsValidSize(std::size_t width, std::size_t height) noexcept {
+    constexpr auto kMaxFileSize = static_cast<std::size_t>(std::min<std::uintmax_t>(
+        static_cast<std::uintmax_t>(std::numeric_limits<off_t>::max()), std::numeric_limits<std::size_t>::max()));
+
+    if ((width == 0U) || (height == 0U) || (width > kMaxFileSize - BitGrid::kWordBits)) {
+      return false;
+    }
+    const std::size_t row_bytes{BitGrid::WordsPerRow(width) * sizeof(Word)};
+    return height <= (kMaxFileSize - kDataOffset) / row_bytes;
+  }
+
+  /// @brief Gets the size of the file holding a grid. The size must have been checked by @c IsValidSize.
+  static std::size_t FileSize(std::size_t width, std::size_t height) noexcept {
+    return kDataOffset + BitGrid::WordsPerRow(width) * height * sizeof(Word);
+  }
+
+  /// @brief Maps an open file. The file is closed on failure.
+  static std::optional<MappedBitGrid> Map(const std::string& path, int file, std::size_t width, std::size_t height) {
+    const std::size_t size{FileSize(width, height)};
+    void* mapping{::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0)};
+    if (mapping == MAP_FAILED) {  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+      ::close(file);
+      return std::nullopt;
+    }
+
+    // The grid is always streamed row by row.
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    return MappedBitGrid(path, file, mapping, size, width, height);
+  }
+
+  /// @brief Constructs an object owning a mapped file.
+  MappedBitGrid(std::string path, int file, void* mapping, std::size_t mapping_size, std::size_t width,
+                std::size_t height) noexcept
+      : path_{std::move(path)},
+        file_{file},
+        mapping_{mapping},
+        mappingSize_{mapping_size},
+        width_{width},
+        height_{height},
+        rowWords_{BitGrid::WordsPerRow(width)} {}
+
+  /// @brief Unmaps and closes the file, if any.
+  void Close() noexcept {
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mappingSize_);
+      mapping_ = nullptr;
+    }
+    if (file_ >= 0) {
+      ::close(file_);
+      file_ = -1;
+    }
+  }
+
+  /// @brief Gets the first row.
+  Word* Data() const noexcept {
+    return reinterpret_cast<Word*>(  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        static_cast<std::uint8_t*>(mapping_) + kDataOffset);
+  }
+
+  /// @brief Computes the page-aligned byte range of the mapping covering a range of rows.
+  /// @param first_row The first row of the range.
+  /// @param end_row The row past the end of the range.
+  /// @param inward @c true to only include the pages completely inside the range, @c false to include every page
+  /// touching the range.
+  /// @param begin The offset of the first byte.
+  /// @param end The offset past the last byte.
+  /// @return @c false if the range is empty.
+  bool PageRange(std::size_t first_row, std::size_t end_row, bool inward, std::size_t& begin,
+                 std::size_t& end) const noexcept {
+    end_row = (end_row < height_) ? end_row : height_;
+    if (first_row >= end_row) {
+      return false;
+    }
+
+    static const auto kPageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t row_bytes{rowWords_ * sizeof(Word)};
+    const std::size_t first_byte{kDataOffset + first_row * row_bytes};
+    const std::size_t end_byte{(end_row == height_) ? mappingSize_ : (kDataOffset + end_row * row_bytes)};
+
+    if (inward) {
+      begin = (first_byte + kPageSize - 1U) / kPageSize * kPageSize;
+      end = (end_byte == mappingSize_) ? mappingSize_ : (end_byte / kPageSize * kPageSize);
+    } else {
+      begin = first_byte / kPageSize * kPageSize;
+      end = end_byte;
+    }
+    return begin < end;
+  }
+
+  /// @brief Gives advice about a range of rows to the kernel.
+  void Advise(std::size_t first_row, std::size_t end_row, int advice, bool inward) const noexcept {
+    std::size_t begin{0U};
+    std::size_t end{0U};
+    if (PageRange(first_row, end_row, inward, begin, end)) {
+      ::madvise(static_cast<std::uint8_t*>(mapping_) + begin, end - begin, advice);
+    }
+  }
+
+  /// @brief Path of the file.
+  std::string path_;
+
+  /// @brief File descriptor of the file.
+  int file_;
+
+  /// @brief Start of the mapping.
+  void* mapping_;
+
+  /// @brief Size of the mapping in bytes.
+  std::size_t mappingSize_;
+
+  /// @brief The width of the grid.
+  std::size_t width_;
+
+  /// @brief The height of the grid.
+  std::size_t height_;
+
+  /// @brief Number of words in a row.
+  std::size_t rowWords_;
+};
+
+}  // namespace host
+
+#endif  // HOST_MAPPED_BIT_GRID_HPP_
@@ -0,0 +1,127 @@
+#ifndef HOST_OUT_OF_CORE_ENGINE_HPP_
+#define HOST_OUT_OF_CORE_ENGINE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bit_packed_game_of_life.hpp"
+#include "mapped_bit_grid.hpp"
+
+namespace host {
+
+/// @brief Advances boards larger than the physical memory.
+///
+/// The current generation and the next one live in two memory-mapped files. A generation is computed by streaming the
+/// board in bands of rows with a rolling window of three bands of the current generation: the previous band, which
+/// provides the row above the current band, the current band, and the next band, which is prefetched while the current
+/// one is computed. Older bands are released, so the resident set does not depend on the board size. The two files are
+/// swapped at the end of each generation.
+///
+/// Each band of the next generation is computed into a buffer, written through the file and written back to the disk
+/// as soon as it is complete. Storing through the mapping would read the generation before last back from the file
+/// just to overwrite it, so a generation reads the board once and writes it once, sequentially.
+class OutOfCoreEngine {
+ public:
+  /// @brief Creates an engine.
+  /// @param grid The initial generation.
+  /// @param next_path Path of the file used for the next generation. An existing file is overwritten. Must not be the
+  /// file of @p grid.
+  /// @param band_rows Number of rows in a band. Zero is treated as one.
+  /// @return The engine, or @c std::nullopt if @p next_path is the file of @p grid or could not be created.
+  static std::optional<OutOfCoreEngine> Create(MappedBitGrid grid, const std::string& next_path,
+                                               std::size_t band_rows) {
+    // Creating the next generation truncates the file, which would raise SIGBUS on the next access to the grid.
+    if ((next_path == grid.GetPath()) || grid.IsBackedBy(next_path)) {
+      return std::nullopt;
+    }
+
+    auto next = MappedBitGrid::Create(next_path, grid.GetWidth(), grid.GetHeight());
+    if (!next) {
+      return std::nullopt;
+    }
+    return OutOfCoreEngine(std::move(grid), std::move(*next), band_rows);
+  }
+
+  /// @brief Advances the board by a number of generations.
+  /// @param generations Number of generations.
+  /// @return @c true on success, @c false if a generation could not be written. The board is then left unchanged.
+  bool Advance(std::size_t generations) noexcept {
+    for (std::size_t i{0U}; i < generations; ++i) {
+      if (!AdvanceGeneration()) {
+        return false;
+      }
+      std::swap(grid_, next_);
+    }
+    return true;
+  }
+
+  /// @brief Gets the current generation.
+  const MappedBitGrid& GetGrid() const noexcept { return grid_; }
+
+  /// @brief Gets the current generation.
+  MappedBitGrid& GetGrid() noexcept { return grid_; }
+
+ private:
+  /// @brief Constructs an engine from two grids of the same size.
+  OutOfCoreEngine(MappedBitGrid grid, MappedBitGrid next, std::size_t band_rows)
+      : grid_{std::move(grid)},
+        next_{std::move(next)},
+        bandRows_{std::max<std::size_t>(band_rows, 1U)},
+        band_(bandRows_ * grid_.GetRowWords()) {}
+
+  /// @brief Computes the next generation into @c next_.
+  /// @return @c true on success, @c false if a band could not be written.
+  bool AdvanceGeneration() noexcept {
+    const std::size_t height{grid_.GetHeight()};
+    const std::size_t words{grid_.GetRowWords()};
+    const MappedBitGrid::Word last_word_mask{BitGrid::LastWordMask(grid_.GetWidth())};
+
+    grid_.WillNeed(0U, bandRows_ + 1U);
+    for (std::size_t band_start{0U}; band_start < height; band_start += bandRows_) {
+      const std::size_t band_end{std::min(band_start + bandRows_, height)};
+
+      // Prefetch the next band, including the row below it, while this one is computed.
+      grid_.WillNeed(band_end + 1U, band_end + bandRows_ + 1U);
+
+      for (std::size_t coord_y{band_start}; coord_y < band_end; ++coord_y) {
+        const MappedBitGrid::Word* above{(coord_y > 0U) ? grid_.Row(coord_y - 1U) : nullptr};
+        const MappedBitGrid::Word* below{(coord_y + 1U < height) ? grid_.Row(coord_y + 1U) : nullptr};
+        bit_packed::NextRow(above, grid_.Row(coord_y), below, &band_[(coord_y - band_start) * words], words,
+                            last_word_mask);
+      }
+      if (!next_.WriteRows(band_start, band_.data(), band_end - band_start)) {
+        grid_.Release(0U, height);
+        return false;
+      }
+      next_.Flush(band_start, band_end);
+
+      // The previous band is not needed anymore.
+      if (band_start >= bandRows_) {
+        grid_.Release(band_start - bandRows_, band_start);
+      }
+    }
+
+    grid_.Release(0U, height);
+    return true;
+  }
+
+  /// @brief The current generation.
+  MappedBitGrid grid_;
+
+  /// @brief The generation being computed.
+  MappedBitGrid next_;
+
+  /// @brief Number of rows in a band.
+  std::size_t bandRows_;
+
+  /// @brief The band of the next generation being computed.
+  std::vector<MappedBitGrid::Word> band_;
+};
+
+}  // namespace host
+
+#endif  // HOST_OUT_OF_CORE_ENGINE_HPP_
@@ -0,0 +1,237 @@
+#ifndef HOST_SNAPSHOT_RING_HPP_
+#define HOST_SNAPSHOT_RING_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace host {
+
+/// @brief What the producer does when the ring is full for a reader.
+enum class BackpressurePolicy {
+  /// @brief Wait until the reader frees a slot. No frame is lost.
+  kBlock,
+  /// @brief Discard the oldest frame the reader has not read yet. The producer never waits for this reader.
+  kDropOldest,
+};
+
+/// @brief Lock-free single-producer/multi-reader ring of frame snapshots.
+///
+/// All the slots are allocated up front from a prototype frame, so publishing only copies the frame into a slot and
+/// never allocates as long as copy-assigning a frame of the same size does not (e.g. @c std::array, @c std::vector).
+/// Each frame is copied once, whatever the number of readers: every reader has its own read position and reads the
+/// frames in place, from its own thread.
+///
+/// A slot being read is never overwritten. When the slot the producer is about to write is still being read by a
+/// @c BackpressurePolicy::kDropOldest reader only, the producer skips it and the readers skip the hole.
+///
+/// @tparam Frame The snapshot type.
+template <typename Frame>
+class SnapshotRing {
+ public:
+  /// @brief Read position of one reader. Created by @c AddReader.
+  class Reader;
+
+  /// @brief Constructs a ring without readers.
+  /// @param capacity Number of slots. Values below two are raised to two.
+  /// @param prototype Frame used to preallocate the slots.
+  SnapshotRing(std::size_t capacity, const Frame& prototype)
+      : slots_(std::max<std::size_t>(capacity, 2U), Slot{0U, prototype}), sequences_(slots_.size()) {
+    for (auto& sequence : sequences_) {
+      sequence.store(kIdle, std::memory_order_relaxed);
+    }
+  }
+
+  /// @brief Adds a reader. Must be called from the producer thread.
+  ///
+  /// The reader starts at the next published frame, the frames already in the ring are not passed to it.
+  ///
+  /// @param policy What to do when the ring is full for this reader.
+  /// @return The reader. It lives as long as the ring.
+  Reader& AddReader(BackpressurePolicy policy) {
+    auto reader = std::make_unique<Reader>(policy);
+    reader->tail_.store(head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    readers_.push_back(std::move(reader));
+    return *readers_.back();
+  }
+
+  /// @brief Stops taking a reader into account, e.g. once its thread is gone. Must be called from the producer thread.
+  /// @param reader The reader.
+  void RemoveReader(Reader& reader) noexcept { reader.attached_ = false; }
+
+  /// @brief Copies a frame into the ring. Must only be called from the producer thread.
+  /// @param generation The generation of the frame.
+  /// @param frame The frame.
+  void Publish(std::uint64_t generation, const Frame& frame) {
+    const std::size_t size{slots_.size()};
+    std::uint64_t head{head_.load(std::memory_order_relaxed)};
+    while (true) {
+      bool full{false};
+      for (const auto& reader : readers_) {
+        full = MakeRoom(*reader, head) || full;
+      }
+      if (full) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      bool in_use{false};
+      bool must_wait{false};
+      for (const auto& reader : readers_) {
+        const std::uint64_t reading{reader->reading_.load()};
+        if (reader->attached_ && (reading != kIdle) && (reading % size == head % size)) {
+          in_use = true;
+          must_wait = must_wait || (reader->policy_ == BackpressurePolicy::kBlock);
+        }
+      }
+      if (!in_use) {
+        break;
+      }
+
+      // The slot is still being read.
+      if (must_wait) {
+        std::this_thread::yield();
+      } else {
+        // Leave a hole, which the readers skip, and move on to the next slot.
+        ++head;
+        head_.store(head, std::memory_order_release);
+      }
+    }
+
+    Slot& slot = slots_[head % size];
+    slot.generation = generation;
+    slot.frame = frame;
+    sequences_[head % size].store(head, std::memory_order_relaxed);
+    head_.store(head + 1U, std::memory_order_release);
+  }
+
+  /// @brief Passes the oldest frame a reader has not read yet to a consumer. Must only be called from the thread of the
+  /// reader.
+  /// @tparam Consumer Callable taking the generation and a const reference to the frame.
+  /// @param reader The reader.
+  /// @param consumer The consumer. The frame reference is only valid during the call.
+  /// @return @c true if a frame was consumed, @c false if there was no frame to read.
+  template <typename Consumer>
+  bool TryConsume(Reader& reader, Consumer&& consumer) {
+    const std::size_t size{slots_.size()};
+    std::uint64_t tail{reader.tail_.load()};
+    while (true) {
+      if (tail == head_.load(std::memory_order_acquire)) {
+        reader.reading_.store(kIdle, std::memory_order_release);
+        return false;
+      }
+
+      // Announce the slot before claiming it, so that the producer does not overwrite it once the tail moves on.
+      reader.reading_.store(tail);
+      if (!reader.tail_.compare_exchange_weak(tail, tail + 1U)) {
+        continue;
+      }
+      if (sequences_[tail % size].load(std::memory_order_relaxed) == tail) {
+        break;
+      }
+      ++tail;  // A hole left by the producer.
+    }
+
+    const Slot& slot = slots_[tail % size];
+    consumer(slot.generation, slot.frame);
+    reader.reading_.store(kIdle, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Checks whether a reader has read every frame.
+  /// @param reader The reader.
+  bool IsEmpty(const Reader& reader) const noexcept {
+    return reader.tail_.load() == head_.load(std::memory_order_acquire);
+  }
+
+ private:
+  /// @brief A frame with its generation.
+  struct Slot {
+    /// @brief The generation of the frame.
+    std::uint64_t generation;
+    /// @brief The frame.
+    Frame frame;
+  };
+
+  /// @brief Value of @c Reader::reading_ when the reader is not reading any slot.
+  static constexpr std::uint64_t kIdle{std::numeric_limits<std::uint64_t>::max()};
+
+  /// @brief Size of a cache line. The indices live on separate lines to avoid false sharing between the threads.
+  static constexpr std::size_t kCacheLineSize{64U};
+
+  /// @brief Makes room for the frame at @p head in the ring of a reader, by discarding its oldest frame if allowed.
+  /// @param reader The reader.
+  /// @param head Index of the frame to write.
+  /// @return @c true if the producer has to wait for the reader, @c false otherwise.
+  bool MakeRoom(Reader& reader, std::uint64_t head) noexcept {
+    const std::size_t size{slots_.size()};
+    std::uint64_t tail{reader.tail_.load()};
+    while (reader.attached_ && (head - tail >= size)) {
+      if (reader.policy_ == BackpressurePolicy::kBlock) {
+        return true;
+      }
+      if (reader.tail_.compare_exchange_strong(tail, tail + 1U)) {
+        // Discarded the oldest unread frame, unless it was a hole. The exchange fails if the reader has just claimed
+        // it.
+        if (sequences_[tail % size].load(std::memory_order_relaxed) == tail) {
+          reader.dropped_.fetch_add(1U, std::memory_order_relaxed);
+        }
+        ++tail;
+      }
+    }
+    return false;
+  }
+
+  /// @brief The slots.
+  std::vector<Slot> slots_;
+
+  /// @brief Index of the frame held by each slot. A slot skipped by the producer keeps an older index.
+  std::vector<std::atomic<std::uint64_t>> sequences_;
+
+  /// @brief The readers. Only accessed from the producer thread.
+  std::vector<std::unique_ptr<Reader>> readers_;
+
+  /// @brief Index of the next frame to write. Only modified by the producer.
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> head_{0U};
+};
+
+/// @brief Read position of one reader of a @c SnapshotRing.
+/// @tparam Frame The snapshot type.
+template <typename Frame>
+class SnapshotRing<Frame>::Reader {
+ public:
+  /// @brief Constructs a reader.
+  /// @param policy What to do when the ring is full for this reader.
+  explicit Reader(BackpressurePolicy policy) noexcept : policy_{policy} {}
+
+  /// @brief Gets the number of frames discarded for this reader.
+  std::uint64_t GetDropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  friend class SnapshotRing;
+
+  /// @brief What to do when the ring is full for this reader.
+  BackpressurePolicy policy_;
+
+  /// @brief Whether the producer takes the reader into account. Only accessed from the producer thread.
+  bool attached_{true};
+
+  /// @brief Index of the next frame to read. Modified by the reader, and by the producer when it drops a frame.
+  alignas(SnapshotRing::kCacheLineSize) std::atomic<std::uint64_t> tail_{0U};
+
+  /// @brief Index of the frame being read, or @c kIdle.
+  alignas(SnapshotRing::kCacheLineSize) std::atomic<std::uint64_t> reading_{SnapshotRing::kIdle};
+
+  /// @brief Number of discarded frames.
+  alignas(SnapshotRing::kCacheLineSize) std::atomic<std::uint64_t> dropped_{0U};
+};
+
+}  // namespace host
+
+#endif  // HOST_SNAPSHOT_RING_HPP_
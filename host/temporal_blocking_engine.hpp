@@ -0,0 +1,151 @@
+#ifndef HOST_TEMPORAL_BLOCKING_ENGINE_HPP_
+#define HOST_TEMPORAL_BLOCKING_ENGINE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "bit_grid.hpp"
+
+namespace host {
+
+/// @brief Configuration of the @c TemporalBlockingEngine.
+///
+/// The ghost rows are recomputed for every tile, so tiles must be large compared to @c generations_per_pass for the
+/// saved memory traffic to pay off. Narrow tiles also pay the fixed cost of each row many times.
+///
+/// The working set is the two scratch buffers holding a tile with its ghost zone. With the defaults, they take
+/// 2 x 258 words x 144 rows, about 580 KiB: they fit in a 1 MiB L2 cache, not in the L1 cache.
+struct TemporalBlockingConfig {
+  /// @brief Number of generations computed per tile before moving to the next one.
+  std::size_t generations_per_pass{8U};
+  /// @brief Width of a tile in cells. Rounded up to a whole number of words.
+  std::size_t tile_width{16384U};
+  /// @brief Height of a tile in rows.
+  std::size_t tile_height{128U};
+};
+
+/// @brief Advances a large grid several generations per cache-resident tile.
+///
+/// @c StepGeneration streams the whole grid through memory once per generation, so large boards are limited by the
+/// memory bandwidth once @c bit_packed::NextRow is vectorized. This engine copies a tile together with a ghost zone of
+/// @c generations_per_pass cells on each side into a small scratch buffer, advances it @c generations_per_pass times
+/// there and writes back only the tile itself. The invalid border grows inwards by one cell per generation and never
+/// reaches the tile (overlapped tiling). The rows that can no longer affect the tile are skipped, which makes the
+/// computed region a trapezoid.
+///
+/// A scalar build is limited by the computation rather than by the memory, and gains nothing from this engine.
+///
+/// The result is identical to calling @c StepGeneration the same number of times.
+class TemporalBlockingEngine {
+ public:
+  /// @brief Constructs an engine.
+  /// @param grid The initial generation.
+  /// @param config The tiling configuration. Zero values are treated as one.
+  TemporalBlockingEngine(BitGrid grid, const TemporalBlockingConfig& config)
+      : generationsPerPass_{std::max<std::size_t>(config.generations_per_pass, 1U)},
+        tileWords_{std::max<std::size_t>(BitGrid::WordsPerRow(config.tile_width), 1U)},
+        tileHeight_{std::max<std::size_t>(config.tile_height, 1U)},
+        ghostWords_{BitGrid::WordsPerRow(generationsPerPass_)},
+        grid_{std::move(grid)},
+        next_{grid_.GetWidth(), grid_.GetHeight()} {
+    const std::size_t scratch_words{(tileWords_ + 2U * ghostWords_) * (tileHeight_ + 2U * generationsPerPass_)};
+    scratch_[0].resize(scratch_words);
+    scratch_[1].resize(scratch_words);
+  }
+
+  /// @brief Advances the grid by a number of generations.
+  /// @param generations Number of generations.
+  void Advance(std::size_t generations) noexcept {
+    while (generations > 0U) {
+      const std::size_t steps{std::min(generations, generationsPerPass_)};
+      for (std::size_t tile_y{0U}; tile_y < grid_.GetHeight(); tile_y += tileHeight_) {
+        for (std::size_t tile_word{0U}; tile_word < grid_.GetRowWords(); tile_word += tileWords_) {
+          AdvanceTile(tile_word, tile_y, steps);
+        }
+      }
+      std::swap(grid_, next_);
+      generations -= steps;
+    }
+  }
+
+  /// @brief Gets the current generation.
+  const BitGrid& GetGrid() const noexcept { return grid_; }
+
+ private:
+  /// @brief Advances one tile and writes it into @c next_.
+  /// @param tile_word Index of the first word of the tile.
+  /// @param tile_y Index of the first row of the tile.
+  /// @param steps Number of generations, not larger than @c generationsPerPass_.
+  void AdvanceTile(std::size_t tile_word, std::size_t tile_y, std::size_t steps) noexcept {
+    const std::size_t height{grid_.GetHeight()};
+    const std::size_t row_words{grid_.GetRowWords()};
+    const std::size_t tile_end_word{std::min(tile_word + tileWords_, row_words)};
+    const std::size_t tile_end_y{std::min(tile_y + tileHeight_, height)};
+
+    // The tile with its ghost zone, clipped to the grid. The cells outside the grid are dead, so no ghost is needed
+    // there and the region can be updated as if it was the whole grid.
+    const std::size_t first_word{(tile_word > ghostWords_) ? (tile_word - ghostWords_) : 0U};
+    const std::size_t end_word{std::min(tile_end_word + ghostWords_, row_words)};
+    const std::size_t first_y{(tile_y > steps) ? (tile_y - steps) : 0U};
+    const std::size_t end_y{std::min(tile_end_y + steps, height)};
+    const std::size_t words{end_word - first_word};
+    const std::size_t rows{end_y - first_y};
+    const bool clipped_top{first_y == 0U};
+    const bool clipped_bottom{end_y == height};
+    const BitGrid::Word last_word_mask{(end_word == row_words) ? BitGrid::LastWordMask(grid_.GetWidth())
+                                                               : ~BitGrid::Word{0U}};
+
+    BitGrid::Word* current{scratch_[0].data()};
+    BitGrid::Word* next{scratch_[1].data()};
+    for (std::size_t row{0U}; row < rows; ++row) {
+      std::copy_n(grid_.Row(first_y + row) + first_word, words, current + row * words);
+    }
+
+    for (std::size_t step{1U}; step <= steps; ++step) {
+      // Rows closer than `step` to a ghost edge are invalid and are not needed by the tile anymore.
+      const std::size_t begin_row{clipped_top ? 0U : step};
+      const std::size_t end_row{clipped_bottom ? rows : (rows - step)};
+      for (std::size_t row{begin_row}; row < end_row; ++row) {
+        const BitGrid::Word* above{(row > 0U) ? (current + (row - 1U) * words) : nullptr};
+        const BitGrid::Word* below{(row + 1U < rows) ? (current + (row + 1U) * words) : nullptr};
+        bit_packed::NextRow(above, current + row * words, below, next + row * words, words, last_word_mask);
+      }
+      std::swap(current, next);
+    }
+
+    const std::size_t tile_words{tile_end_word - tile_word};
+    for (std::size_t coord_y{tile_y}; coord_y < tile_end_y; ++coord_y) {
+      const BitGrid::Word* source{current + (coord_y - first_y) * words + (tile_word - first_word)};
+      std::copy_n(source, tile_words, next_.Row(coord_y) + tile_word);
+    }
+  }
+
+  /// @brief Number of generations computed per tile.
+  std::size_t generationsPerPass_;
+
+  /// @brief Width of a tile in words.
+  std::size_t tileWords_;
+
+  /// @brief Height of a tile in rows.
+  std::size_t tileHeight_;
+
+  /// @brief Width of the ghost zone in words.
+  std::size_t ghostWords_;
+
+  /// @brief The current generation.
+  BitGrid grid_;
+
+  /// @brief The generation being computed.
+  BitGrid next_;
+
+  /// @brief Ping-pong buffers holding a tile with its ghost zone.
+  std::array<std::vector<BitGrid::Word>, 2> scratch_;
+};
+
+}  // namespace host
+
+#endif  // HOST_TEMPORAL_BLOCKING_ENGINE_HPP_
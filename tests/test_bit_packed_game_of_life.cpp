@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include "bit_packed_game_of_life.hpp"
+#include "game_of_life.hpp"
+
+template <std::uint16_t Width, std::uint16_t Height>
+std::string ToString(const BitPackedGameOfLife<Width, Height>& game) {
+  std::string result;
+  for (std::uint16_t coord_y{0U}; coord_y < Height; ++coord_y) {
+    for (std::uint16_t coord_x{0U}; coord_x < Width; ++coord_x) {
+      result += game.IsAlive(coord_x, coord_y) ? '1' : '0';
+    }
+    result += '\n';
+  }
+  return result;
+}
+
+TEST(BitPackedGameOfLifeTest, SetCell) {
+  BitPackedGameOfLife<40U, 3U> game;
+  game.SetCell(0U, 0U, true);
+  game.SetCell(31U, 1U, true);
+  game.SetCell(32U, 1U, true);
+  game.SetCell(39U, 2U, true);
+  game.SetCell(40U, 2U, true);  // Outside, ignored.
+
+  EXPECT_TRUE(game.IsAlive(0U, 0U));
+  EXPECT_TRUE(game.IsAlive(31U, 1U));
+  EXPECT_TRUE(game.IsAlive(32U, 1U));
+  EXPECT_TRUE(game.IsAlive(39U, 2U));
+  EXPECT_FALSE(game.IsAlive(40U, 2U));
+  EXPECT_FALSE(game.IsAlive(1U, 0U));
+
+  game.SetCell(31U, 1U, false);
+  EXPECT_FALSE(game.IsAlive(31U, 1U));
+  EXPECT_TRUE(game.IsAlive(32U, 1U));
+}
+
+TEST(BitPackedGameOfLifeTest, BlinkerAcrossWordBoundary) {
+  BitPackedGameOfLife<64U, 3U> game;
+  game.SetCell(31U, 1U, true);
+  game.SetCell(32U, 1U, true);
+  game.SetCell(33U, 1U, true);
+
+  game.UpdateGameGrid();
+  for (std::uint16_t coord_y{0U}; coord_y < 3U; ++coord_y) {
+    for (std::uint16_t coord_x{0U}; coord_x < 64U; ++coord_x) {
+      const bool expected{coord_x == 32U};
+      ASSERT_EQ(game.IsAlive(coord_x, coord_y), expected) << ToString(game);
+    }
+  }
+
+  game.UpdateGameGrid();
+  EXPECT_TRUE(game.IsAlive(31U, 1U)) << ToString(game);
+  EXPECT_TRUE(game.IsAlive(32U, 1U)) << ToString(game);
+  EXPECT_TRUE(game.IsAlive(33U, 1U)) << ToString(game);
+  EXPECT_FALSE(game.IsAlive(32U, 0U)) << ToString(game);
+}
+
+TEST(BitPackedGameOfLifeTest, RightEdgeIsDead) {
+  // A blinker on the right edge of a row that does not fill the last word must not grow past the edge.
+  BitPackedGameOfLife<35U, 5U> game;
+  game.SetCell(34U, 1U, true);
+  game.SetCell(34U, 2U, true);
+  game.SetCell(34U, 3U, true);
+
+  game.UpdateGameGrid();
+  EXPECT_TRUE(game.IsAlive(33U, 2U)) << ToString(game);
+  EXPECT_TRUE(game.IsAlive(34U, 2U)) << ToString(game);
+  EXPECT_EQ(game.GetGameGrid()[2].back(), 0x6U) << ToString(game);
+}
+
+/// @brief Checks that a bit-packed game evolves like the reference implementation from the same random grid.
+template <std::uint8_t Width, std::uint8_t Height>
+void ExpectMatchesGameOfLife() {
+  constexpr std::uint32_t kSeed{42U};
+
+  GameOfLife<Width, Height> reference(kSeed);
+  BitPackedGameOfLife<Width, Height> game;
+  const auto& initial = reference.GetGameGrid();
+  for (std::uint16_t coord_y{0U}; coord_y < Height; ++coord_y) {
+    for (std::uint16_t coord_x{0U}; coord_x < Width; ++coord_x) {
+      game.SetCell(coord_x, coord_y, initial[coord_y][coord_x] != 0U);
+    }
+  }
+
+  constexpr std::uint32_t kIterations{50U};
+  for (std::uint32_t i{0U}; i < kIterations; ++i) {
+    reference.UpdateGameGrid();
+    game.UpdateGameGrid();
+
+    const auto& grid = reference.GetGameGrid();
+    for (std::uint16_t coord_y{0U}; coord_y < Height; ++coord_y) {
+      for (std::uint16_t coord_x{0U}; coord_x < Width; ++coord_x) {
+        ASSERT_EQ(game.IsAlive(coord_x, coord_y), grid[coord_y][coord_x] != 0U)
+            << "x=" << coord_x << ", y=" << coord_y << ", i=" << i;
+      }
+    }
+  }
+}
+
+TEST(BitPackedGameOfLifeTest, MatchesGameOfLife) { ExpectMatchesGameOfLife<100U, 70U>(); }
+
+TEST(BitPackedGameOfLifeTest, MatchesGameOfLifeWithOneWordPerRow) { ExpectMatchesGameOfLife<20U, 30U>(); }
+
+TEST(BitPackedGameOfLifeTest, Activity) {
+  using Game = BitPackedGameOfLife<256U, 256U>;
+  Game game;
+
+  // A still block does not produce any activity.
+  game.SetCell(10U, 10U, true);
+  game.SetCell(11U, 10U, true);
+  game.SetCell(10U, 11U, true);
+  game.SetCell(11U, 11U, true);
+  game.UpdateGameGrid();
+  EXPECT_EQ(game.GetActivity().changed_cells, 0U);
+
+  // A blinker changes four cells per generation.
+  game.SetCell(200U, 150U, true);
+  game.SetCell(200U, 151U, true);
+  game.SetCell(200U, 152U, true);
+  game.UpdateGameGrid();
+
+  // The changes are counted in the block holding the blinker.
+  const auto& activity = game.GetActivity();
+  EXPECT_EQ(activity.changed_cells, 4U);
+  for (std::uint16_t block_row{0U}; block_row < Game::kBlockRows; ++block_row) {
+    for (std::uint16_t block_column{0U}; block_column < Game::kBlockColumns; ++block_column) {
+      const bool active{(block_row == 150U / Game::kBlockSize) && (block_column == 200U / Game::kBlockSize)};
+      EXPECT_EQ(activity.blocks[block_row][block_column].changed_cells, active ? 4U : 0U);
+    }
+  }
+
+  const auto& block = activity.blocks[150U / Game::kBlockSize][200U / Game::kBlockSize];
+  EXPECT_EQ(block.center_y, 151U);
+  EXPECT_EQ(block.center_x / Game::kWordBits, 200U / Game::kWordBits);
+}
@@ -0,0 +1,333 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame_consumers.hpp"
+#include "frame_pipeline.hpp"
+#include "game_of_life.hpp"
+#include "snapshot_ring.hpp"
+
+namespace {
+
+using Frame = std::array<std::uint32_t, 4>;
+
+/// @brief Builds a frame whose cells all hold the given value.
+Frame MakeFrame(std::uint32_t value) { return {value, value, value, value}; }
+
+/// @brief Frame counting how many times frames are copied.
+struct CountingFrame {
+  CountingFrame() = default;
+  CountingFrame(const CountingFrame& /*other*/) { ++copies; }
+  CountingFrame(CountingFrame&&) = delete;
+  CountingFrame& operator=(const CountingFrame& /*other*/) {
+    ++copies;
+    return *this;
+  }
+  CountingFrame& operator=(CountingFrame&&) = delete;
+  ~CountingFrame() = default;
+
+  static inline std::uint32_t copies{0U};
+};
+
+}  // namespace
+
+TEST(SnapshotRingTest, FirstInFirstOut) {
+  host::SnapshotRing<Frame> ring(4U, Frame{});
+  auto& reader = ring.AddReader(host::BackpressurePolicy::kBlock);
+  EXPECT_TRUE(ring.IsEmpty(reader));
+
+  for (std::uint32_t i{0U}; i < 3U; ++i) {
+    ring.Publish(i, MakeFrame(i));
+  }
+
+  for (std::uint32_t i{0U}; i < 3U; ++i) {
+    ASSERT_TRUE(ring.TryConsume(reader, [i](std::uint64_t generation, const Frame& frame) {
+      EXPECT_EQ(generation, i);
+      EXPECT_EQ(frame, MakeFrame(i));
+    }));
+  }
+  EXPECT_TRUE(ring.IsEmpty(reader));
+  EXPECT_FALSE(ring.TryConsume(reader, [](std::uint64_t /*generation*/, const Frame& /*frame*/) { FAIL(); }));
+}
+
+TEST(SnapshotRingTest, DropOldest) {
+  host::SnapshotRing<Frame> ring(4U, Frame{});
+  auto& reader = ring.AddReader(host::BackpressurePolicy::kDropOldest);
+
+  // Without a consumer, only the last four frames are kept.
+  constexpr std::uint32_t kFrames{10U};
+  for (std::uint32_t i{0U}; i < kFrames; ++i) {
+    ring.Publish(i, MakeFrame(i));
+  }
+  EXPECT_EQ(reader.GetDropped(), 6U);
+
+  std::vector<std::uint64_t> generations;
+  while (ring.TryConsume(reader, [&generations](std::uint64_t generation, const Frame& frame) {
+    EXPECT_EQ(frame, MakeFrame(static_cast<std::uint32_t>(generation)));
+    generations.push_back(generation);
+  })) {
+  }
+  EXPECT_EQ(generations, (std::vector<std::uint64_t>{6U, 7U, 8U, 9U}));
+}
+
+TEST(SnapshotRingTest, DropOldestNeverOverwritesTheSlotBeingRead) {
+  host::SnapshotRing<Frame> ring(2U, Frame{});
+  auto& reader = ring.AddReader(host::BackpressurePolicy::kDropOldest);
+  ring.Publish(0U, MakeFrame(0U));
+
+  ASSERT_TRUE(ring.TryConsume(reader, [&ring](std::uint64_t generation, const Frame& frame) {
+    // The producer laps the consumer while the frame is being read.
+    ring.Publish(1U, MakeFrame(1U));
+    ring.Publish(2U, MakeFrame(2U));
+    ring.Publish(3U, MakeFrame(3U));
+    EXPECT_EQ(generation, 0U);
+    EXPECT_EQ(frame, MakeFrame(0U));
+  }));
+  EXPECT_EQ(reader.GetDropped(), 2U);
+
+  ASSERT_TRUE(ring.TryConsume(reader, [](std::uint64_t generation, const Frame& frame) {
+    EXPECT_EQ(generation, 3U);
+    EXPECT_EQ(frame, MakeFrame(3U));
+  }));
+  EXPECT_TRUE(ring.IsEmpty(reader));
+}
+
+TEST(SnapshotRingTest, BlockLosesNothingAcrossThreads) {
+  host::SnapshotRing<Frame> ring(3U, Frame{});
+  auto& reader = ring.AddReader(host::BackpressurePolicy::kBlock);
+  constexpr std::uint32_t kFrames{500U};
+
+  std::thread consumer([&ring, &reader]() {
+    std::uint32_t expected{0U};
+    while (expected < kFrames) {
+      ring.TryConsume(reader, [&expected](std::uint64_t generation, const Frame& frame) {
+        ASSERT_EQ(generation, expected);
+        ASSERT_EQ(frame, MakeFrame(expected));
+        ++expected;
+      });
+    }
+  });
+
+  for (std::uint32_t i{0U}; i < kFrames; ++i) {
+    ring.Publish(i, MakeFrame(i));
+  }
+  consumer.join();
+
+  EXPECT_EQ(reader.GetDropped(), 0U);
+  EXPECT_TRUE(ring.IsEmpty(reader));
+}
+
+TEST(SnapshotRingTest, DropOldestKeepsOrderAcrossThreads) {
+  host::SnapshotRing<Frame> ring(4U, Frame{});
+  auto& reader = ring.AddReader(host::BackpressurePolicy::kDropOldest);
+  constexpr std::uint32_t kFrames{2000U};
+
+  std::uint64_t received{0U};
+  std::thread consumer([&ring, &reader, &received]() {
+    std::int64_t last{-1};
+    while (last + 1 < static_cast<std::int64_t>(kFrames)) {
+      ring.TryConsume(reader, [&last, &received](std::uint64_t generation, const Frame& frame) {
+        ASSERT_GT(static_cast<std::int64_t>(generation), last);
+        ASSERT_EQ(frame, MakeFrame(static_cast<std::uint32_t>(generation)));
+        last = static_cast<std::int64_t>(generation);
+        ++received;
+      });
+    }
+  });
+
+  for (std::uint32_t i{0U}; i < kFrames; ++i) {
+    ring.Publish(i, MakeFrame(i));
+  }
+  consumer.join();
+
+  EXPECT_EQ(received + reader.GetDropped(), kFrames);
+}
+
+TEST(SnapshotRingTest, ReadersAreIndependent) {
+  host::SnapshotRing<Frame> ring(4U, Frame{});
+  auto& fast = ring.AddReader(host::BackpressurePolicy::kBlock);
+  auto& slow = ring.AddReader(host::BackpressurePolicy::kDropOldest);
+
+  // The fast reader keeps up, the slow one never reads and only keeps the last four frames.
+  constexpr std::uint32_t kFrames{10U};
+  std::vector<std::uint64_t> fast_generations;
+  for (std::uint32_t i{0U}; i < kFrames; ++i) {
+    ring.Publish(i, MakeFrame(i));
+    ASSERT_TRUE(ring.TryConsume(fast, [&fast_generations](std::uint64_t generation, const Frame& /*frame*/) {
+      fast_generations.push_back(generation);
+    }));
+  }
+  EXPECT_EQ(fast_generations.size(), kFrames);
+  EXPECT_EQ(fast.GetDropped(), 0U);
+  EXPECT_EQ(slow.GetDropped(), 6U);
+
+  std::vector<std::uint64_t> slow_generations;
+  while (ring.TryConsume(slow, [&slow_generations](std::uint64_t generation, const Frame& frame) {
+    EXPECT_EQ(frame, MakeFrame(static_cast<std::uint32_t>(generation)));
+    slow_generations.push_back(generation);
+  })) {
+  }
+  EXPECT_EQ(slow_generations, (std::vector<std::uint64_t>{6U, 7U, 8U, 9U}));
+}
+
+TEST(SnapshotRingTest, MixedPoliciesAcrossThreads) {
+  host::SnapshotRing<Frame> ring(3U, Frame{});
+  auto& blocking = ring.AddReader(host::BackpressurePolicy::kBlock);
+  auto& dropping = ring.AddReader(host::BackpressurePolicy::kDropOldest);
+  constexpr std::uint32_t kFrames{500U};
+
+  std::thread blocking_consumer([&ring, &blocking]() {
+    std::uint32_t expected{0U};
+    while (expected < kFrames) {
+      ring.TryConsume(blocking, [&expected](std::uint64_t generation, const Frame& frame) {
+        ASSERT_EQ(generation, expected);
+        ASSERT_EQ(frame, MakeFrame(expected));
+        ++expected;
+      });
+    }
+  });
+
+  std::uint64_t received{0U};
+  std::thread dropping_consumer([&ring, &dropping, &received]() {
+    std::int64_t last{-1};
+    while (last + 1 < static_cast<std::int64_t>(kFrames)) {
+      ring.TryConsume(dropping, [&last, &received](std::uint64_t generation, const Frame& frame) {
+        ASSERT_GT(static_cast<std::int64_t>(generation), last);
+        ASSERT_EQ(frame, MakeFrame(static_cast<std::uint32_t>(generation)));
+        last = static_cast<std::int64_t>(generation);
+        ++received;
+      });
+    }
+  });
+
+  for (std::uint32_t i{0U}; i < kFrames; ++i) {
+    ring.Publish(i, MakeFrame(i));
+  }
+  blocking_consumer.join();
+  dropping_consumer.join();
+
+  EXPECT_EQ(blocking.GetDropped(), 0U);
+  EXPECT_EQ(received + dropping.GetDropped(), kFrames);
+}
+
+TEST(SnapshotRingTest, LateReaderStartsAtTheNextFrame) {
+  host::SnapshotRing<Frame> ring(2U, Frame{});
+  auto& first = ring.AddReader(host::BackpressurePolicy::kDropOldest);
+  for (std::uint32_t i{0U}; i < 5U; ++i) {
+    ring.Publish(i, MakeFrame(i));
+  }
+
+  // A blocking reader added now does not hold back the producer with the frames already in the ring.
+  auto& late = ring.AddReader(host::BackpressurePolicy::kBlock);
+  EXPECT_TRUE(ring.IsEmpty(late));
+  ring.Publish(5U, MakeFrame(5U));
+
+  std::vector<std::uint64_t> generations;
+  while (ring.TryConsume(late, [&generations](std::uint64_t generation, const Frame& /*frame*/) {
+    generations.push_back(generation);
+  })) {
+  }
+  EXPECT_EQ(generations, (std::vector<std::uint64_t>{5U}));
+  EXPECT_FALSE(ring.IsEmpty(first));
+}
+
+TEST(FramePipelineTest, CopiesEachFrameOnce) {
+  const CountingFrame frame;
+  std::atomic<std::uint32_t> received{0U};
+  constexpr std::uint32_t kFrames{20U};
+  {
+    host::FramePipeline<CountingFrame> pipeline(4U, frame);
+    for (std::uint32_t stage{0U}; stage < 3U; ++stage) {
+      pipeline.AddStage(host::BackpressurePolicy::kBlock,
+                        [&received](std::uint64_t /*generation*/, const CountingFrame& /*frame*/) { ++received; });
+    }
+
+    CountingFrame::copies = 0U;
+    for (std::uint32_t i{0U}; i < kFrames; ++i) {
+      pipeline.Publish(i, frame);
+    }
+    EXPECT_EQ(CountingFrame::copies, kFrames);
+    pipeline.Stop();
+  }
+  EXPECT_EQ(received, 3U * kFrames);
+}
+
+TEST(FramePipelineTest, PublishAfterStopDoesNotBlock) {
+  host::FramePipeline<Frame> pipeline(2U, Frame{});
+  auto& stage = pipeline.AddStage(host::BackpressurePolicy::kBlock, [](std::uint64_t, const Frame&) {});
+  std::uint32_t received{0U};
+  pipeline.AddStage(host::BackpressurePolicy::kBlock, [&received](std::uint64_t, const Frame&) { ++received; });
+
+  // A stopped stage does not hold back the producer anymore.
+  stage.Stop();
+  constexpr std::uint32_t kFrames{10U};
+  for (std::uint32_t i{0U}; i < kFrames; ++i) {
+    pipeline.Publish(i, MakeFrame(i));
+  }
+
+  pipeline.Stop();
+  EXPECT_EQ(received, kFrames);
+  for (std::uint32_t i{0U}; i < kFrames; ++i) {
+    pipeline.Publish(i, MakeFrame(i));
+  }
+}
+
+TEST(FramePipelineTest, GameOfLife) {
+  using Game = GameOfLife<16U, 8U>;
+  Game game(42U);
+
+  host::PopulationStats<Game::GameBuffer> stats;
+  std::ostringstream pbm;
+
+  constexpr std::uint32_t kGenerations{100U};
+  {
+    host::FramePipeline<Game::GameBuffer> pipeline(4U, game.GetGameGrid());
+    pipeline.AddStage(host::BackpressurePolicy::kBlock, std::ref(stats));
+    pipeline.AddStage(host::BackpressurePolicy::kBlock, host::PbmWriter<Game::GameBuffer>(pbm, game.GetGameGrid()));
+
+    for (std::uint32_t i{0U}; i < kGenerations; ++i) {
+      game.UpdateGameGrid();
+      pipeline.Publish(i, game.GetGameGrid());
+    }
+    pipeline.Stop();
+  }
+
+  std::uint64_t population{0U};
+  for (const auto& row : game.GetGameGrid()) {
+    for (const auto cell : row) {
+      population += cell;
+    }
+  }
+
+  EXPECT_EQ(stats.GetFrames(), kGenerations);
+  EXPECT_EQ(stats.GetLastGeneration(), kGenerations - 1U);
+  EXPECT_EQ(stats.GetLastPopulation(), population);
+  EXPECT_LE(stats.GetMinPopulation(), stats.GetMaxPopulation());
+
+  // Every image is an 8 bytes header followed by 8 rows of 2 bytes.
+  const std::string output{pbm.str()};
+  constexpr std::size_t kImageSize{8U + 8U * 2U};
+  ASSERT_EQ(output.size(), kGenerations * kImageSize);
+  EXPECT_EQ(output.substr(0U, 8U), "P4\n16 8\n");
+}
+
+TEST(FramePipelineTest, PbmWriterBitGrid) {
+  host::BitGrid grid(10U, 2U);
+  grid.SetCell(0U, 0U, true);
+  grid.SetCell(9U, 0U, true);
+  grid.SetCell(1U, 1U, true);
+
+  std::ostringstream pbm;
+  host::PbmWriter<host::BitGrid> writer(pbm, grid);
+  writer(0U, grid);
+
+  const std::string expected{"P4\n10 2\n\x80\x40\x40\x00", 12U};
+  EXPECT_EQ(pbm.str(), expected);
+}
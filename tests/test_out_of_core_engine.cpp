@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bit_grid.hpp"
+#include "mapped_bit_grid.hpp"
+#include "out_of_core_engine.hpp"
+
+namespace {
+
+/// @brief Removes the files created by a test.
+class OutOfCoreEngineTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    std::remove(currentPath_.c_str());
+    std::remove(nextPath_.c_str());
+  }
+
+  const std::string currentPath_{::testing::TempDir() + "out_of_core_current.bin"};
+  const std::string nextPath_{::testing::TempDir() + "out_of_core_next.bin"};
+};
+
+/// @brief Checks that a mapped grid holds the same cells as an in-memory grid.
+::testing::AssertionResult SameCells(const host::MappedBitGrid& mapped, const host::BitGrid& grid) {
+  for (std::size_t coord_y{0U}; coord_y < grid.GetHeight(); ++coord_y) {
+    for (std::size_t index{0U}; index < grid.GetRowWords(); ++index) {
+      if (mapped.Row(coord_y)[index] != grid.Row(coord_y)[index]) {
+        return ::testing::AssertionFailure() << "row " << coord_y << ", word " << index;
+      }
+    }
+  }
+  return ::testing::AssertionSuccess();
+}
+
+}  // namespace
+
+TEST_F(OutOfCoreEngineTest, CreateAndOpen) {
+  {
+    auto grid = host::MappedBitGrid::Create(currentPath_, 100U, 20U);
+    ASSERT_TRUE(grid);
+    grid->SetCell(0U, 0U, true);
+    grid->SetCell(99U, 19U, true);
+    ASSERT_TRUE(grid->Sync());
+  }
+
+  const auto grid = host::MappedBitGrid::Open(currentPath_);
+  ASSERT_TRUE(grid);
+  EXPECT_EQ(grid->GetWidth(), 100U);
+  EXPECT_EQ(grid->GetHeight(), 20U);
+  EXPECT_TRUE(grid->IsAlive(0U, 0U));
+  EXPECT_TRUE(grid->IsAlive(99U, 19U));
+  EXPECT_FALSE(grid->IsAlive(1U, 0U));
+}
+
+TEST_F(OutOfCoreEngineTest, OpenInvalidFile) {
+  EXPECT_FALSE(host::MappedBitGrid::Open(currentPath_));
+
+  std::FILE* file{std::fopen(currentPath_.c_str(), "w")};
+  ASSERT_NE(file, nullptr);
+  std::fputs("not a grid", file);
+  std::fclose(file);
+  EXPECT_FALSE(host::MappedBitGrid::Open(currentPath_));
+
+  EXPECT_FALSE(host::MappedBitGrid::Create(currentPath_, 0U, 10U));
+}
+
+TEST_F(OutOfCoreEngineTest, OpenRejectsOverflowingSize) {
+  // A width close to the maximum wraps the row size around to zero words, which would match a header-only file.
+  constexpr std::size_t kHeaderSize{64U};
+  constexpr std::uint64_t kMagic{0x444952474546494CU};
+  const std::array<std::uint64_t, kHeaderSize / sizeof(std::uint64_t)> header{
+      kMagic, std::numeric_limits<std::uint64_t>::max() - 10U, 1U};
+
+  std::FILE* file{std::fopen(currentPath_.c_str(), "wb")};
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(std::fwrite(header.data(), sizeof(header), 1U, file), 1U);
+  std::fclose(file);
+  EXPECT_FALSE(host::MappedBitGrid::Open(currentPath_));
+
+  EXPECT_FALSE(host::MappedBitGrid::Create(currentPath_, std::numeric_limits<std::size_t>::max(), 1U));
+  EXPECT_FALSE(host::MappedBitGrid::Create(currentPath_, 64U, std::numeric_limits<std::size_t>::max()));
+}
+
+TEST_F(OutOfCoreEngineTest, WriteRowsIsVisibleThroughTheMapping) {
+  auto grid = host::MappedBitGrid::Create(currentPath_, 100U, 8U);
+  ASSERT_TRUE(grid);
+  grid->SetCell(5U, 6U, true);
+
+  // Two rows with the cell 70 alive, the second one past the end of the grid.
+  std::vector<host::MappedBitGrid::Word> rows(2U * grid->GetRowWords());
+  rows[1] = host::MappedBitGrid::Word{1U} << 6U;
+  rows[grid->GetRowWords() + 1U] = rows[1];
+  ASSERT_TRUE(grid->WriteRows(7U, rows.data(), 2U));
+  ASSERT_TRUE(grid->WriteRows(6U, rows.data(), 1U));
+
+  EXPECT_FALSE(grid->IsAlive(5U, 6U));
+  EXPECT_TRUE(grid->IsAlive(70U, 6U));
+  EXPECT_TRUE(grid->IsAlive(70U, 7U));
+  ASSERT_TRUE(grid->Sync());
+
+  const auto reopened = host::MappedBitGrid::Open(currentPath_);
+  ASSERT_TRUE(reopened);
+  EXPECT_TRUE(reopened->IsAlive(70U, 7U));
+}
+
+TEST_F(OutOfCoreEngineTest, MatchesStepGeneration) {
+  constexpr std::size_t kWidth{333U};
+  constexpr std::size_t kHeight{517U};
+  constexpr std::size_t kGenerations{6U};
+
+  for (const std::size_t band_rows : {1U, 7U, 64U, 1000U}) {
+    auto mapped = host::MappedBitGrid::Create(currentPath_, kWidth, kHeight);
+    ASSERT_TRUE(mapped);
+    mapped->Randomize(static_cast<std::uint32_t>(band_rows), band_rows);
+
+    host::BitGrid grid(kWidth, kHeight);
+    for (std::size_t coord_y{0U}; coord_y < kHeight; ++coord_y) {
+      std::copy_n(mapped->Row(coord_y), grid.GetRowWords(), grid.Row(coord_y));
+    }
+
+    auto engine = host::OutOfCoreEngine::Create(std::move(*mapped), nextPath_, band_rows);
+    ASSERT_TRUE(engine);
+
+    host::BitGrid next(kWidth, kHeight);
+    for (std::size_t i{0U}; i < kGenerations; ++i) {
+      ASSERT_TRUE(engine->Advance(1U));
+      host::StepGeneration(grid, next);
+      std::swap(grid, next);
+      ASSERT_TRUE(SameCells(engine->GetGrid(), grid)) << "band_rows=" << band_rows << ", i=" << i;
+    }
+  }
+}
+
+TEST_F(OutOfCoreEngineTest, RejectsTheFileOfTheGrid) {
+  auto mapped = host::MappedBitGrid::Create(currentPath_, 64U, 64U);
+  ASSERT_TRUE(mapped);
+  mapped->SetCell(1U, 1U, true);
+
+  EXPECT_FALSE(host::OutOfCoreEngine::Create(std::move(*mapped), currentPath_, 16U));
+
+  // The same file under another name.
+  mapped = host::MappedBitGrid::Open(currentPath_);
+  ASSERT_TRUE(mapped);
+  const std::string alias_path{::testing::TempDir() + "./out_of_core_current.bin"};
+  EXPECT_FALSE(host::OutOfCoreEngine::Create(std::move(*mapped), alias_path, 16U));
+
+  // The file was left untouched.
+  mapped = host::MappedBitGrid::Open(currentPath_);
+  ASSERT_TRUE(mapped);
+  EXPECT_TRUE(mapped->IsAlive(1U, 1U));
+}
+
+TEST_F(OutOfCoreEngineTest, FilesAreSwapped) {
+  auto mapped = host::MappedBitGrid::Create(currentPath_, 64U, 64U);
+  ASSERT_TRUE(mapped);
+  auto engine = host::OutOfCoreEngine::Create(std::move(*mapped), nextPath_, 16U);
+  ASSERT_TRUE(engine);
+
+  ASSERT_TRUE(engine->Advance(1U));
+  EXPECT_EQ(engine->GetGrid().GetPath(), nextPath_);
+  ASSERT_TRUE(engine->Advance(1U));
+  EXPECT_EQ(engine->GetGrid().GetPath(), currentPath_);
+}
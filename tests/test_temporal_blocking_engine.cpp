@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "bit_grid.hpp"
+#include "temporal_blocking_engine.hpp"
+
+namespace {
+
+/// @brief Advances a grid with one streaming pass per generation.
+host::BitGrid Reference(host::BitGrid grid, std::size_t generations) {
+  host::BitGrid next(grid.GetWidth(), grid.GetHeight());
+  for (std::size_t i{0U}; i < generations; ++i) {
+    host::StepGeneration(grid, next);
+    std::swap(grid, next);
+  }
+  return grid;
+}
+
+std::string ToString(const host::BitGrid& grid) {
+  std::string result;
+  for (std::size_t coord_y{0U}; coord_y < grid.GetHeight(); ++coord_y) {
+    for (std::size_t coord_x{0U}; coord_x < grid.GetWidth(); ++coord_x) {
+      result += grid.IsAlive(coord_x, coord_y) ? '1' : '0';
+    }
+    result += '\n';
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(BitGridTest, Glider) {
+  // A glider crossing the word boundary.
+  host::BitGrid grid(130U, 6U);
+  grid.SetCell(63U, 0U, true);
+  grid.SetCell(64U, 1U, true);
+  grid.SetCell(62U, 2U, true);
+  grid.SetCell(63U, 2U, true);
+  grid.SetCell(64U, 2U, true);
+
+  const auto result = Reference(grid, 4U);
+
+  host::BitGrid expected(130U, 6U);
+  expected.SetCell(64U, 1U, true);
+  expected.SetCell(65U, 2U, true);
+  expected.SetCell(63U, 3U, true);
+  expected.SetCell(64U, 3U, true);
+  expected.SetCell(65U, 3U, true);
+  ASSERT_EQ(result, expected) << ToString(result);
+}
+
+TEST(TemporalBlockingEngineTest, MatchesStepGeneration) {
+  struct TestCase {
+    std::size_t width;
+    std::size_t height;
+    host::TemporalBlockingConfig config;
+    std::size_t generations;
+  };
+
+  const TestCase kCases[] = {
+      {200U, 150U, {1U, 64U, 16U}, 5U},      // One generation per pass.
+      {200U, 150U, {4U, 64U, 16U}, 10U},     // Generations not a multiple of the pass length.
+      {321U, 97U, {8U, 128U, 10U}, 24U},     // Partial tiles on the right and bottom edges.
+      {300U, 300U, {70U, 64U, 32U}, 70U},    // Ghost zone wider than a word.
+      {64U, 40U, {16U, 4096U, 4096U}, 33U},  // A single tile covering the whole grid.
+      {1000U, 3U, {6U, 1U, 1U}, 12U},        // Minimal tiles.
+  };
+
+  std::uint32_t seed{1U};
+  for (const auto& test_case : kCases) {
+    host::BitGrid grid(test_case.width, test_case.height);
+    grid.Randomize(seed++);
+
+    const auto expected = Reference(grid, test_case.generations);
+
+    host::TemporalBlockingEngine engine(grid, test_case.config);
+    engine.Advance(test_case.generations);
+
+    ASSERT_EQ(engine.GetGrid(), expected)
+        << "width=" << test_case.width << ", height=" << test_case.height
+        << ", generations_per_pass=" << test_case.config.generations_per_pass
+        << ", tile_width=" << test_case.config.tile_width << ", tile_height=" << test_case.config.tile_height;
+  }
+}
+
+TEST(TemporalBlockingEngineTest, AdvanceInSeveralCalls) {
+  host::BitGrid grid(257U, 129U);
+  grid.Randomize(7U);
+
+  host::TemporalBlockingEngine engine(grid, {5U, 64U, 32U});
+  engine.Advance(3U);
+  engine.Advance(9U);
+  engine.Advance(0U);
+
+  ASSERT_EQ(engine.GetGrid(), Reference(grid, 12U));
+}
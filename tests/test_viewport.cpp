@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "bit_packed_game_of_life.hpp"
+#include "viewport.hpp"
+
+namespace {
+
+/// @brief Display stub recording the pixels set by the viewport.
+template <std::uint16_t Width, std::uint16_t Height>
+struct FakeDisplay {
+  void SetPixel(std::uint16_t coord_x, std::uint16_t coord_y, bool set) {
+    ASSERT_LT(coord_x, Width);
+    ASSERT_LT(coord_y, Height);
+    pixels[coord_y][coord_x] = set;
+    ++calls;
+  }
+
+  std::array<std::array<bool, Width>, Height> pixels{};
+  std::uint32_t calls{0U};
+};
+
+using World = BitPackedGameOfLife<256U, 128U>;
+using WorldViewport = Viewport<World, 16U, 8U>;
+
+}  // namespace
+
+TEST(ViewportTest, CenteredByDefault) {
+  const WorldViewport viewport;
+  EXPECT_EQ(viewport.GetOriginX(), 120U);
+  EXPECT_EQ(viewport.GetOriginY(), 60U);
+}
+
+TEST(ViewportTest, MoveToClamps) {
+  WorldViewport viewport;
+  viewport.MoveTo(250U, 125U);
+  EXPECT_EQ(viewport.GetOriginX(), 240U);
+  EXPECT_EQ(viewport.GetOriginY(), 120U);
+
+  viewport.CenterOn(3U, 2U);
+  EXPECT_EQ(viewport.GetOriginX(), 0U);
+  EXPECT_EQ(viewport.GetOriginY(), 0U);
+}
+
+TEST(ViewportTest, RendersOnlyTheWindow) {
+  World world;
+  world.SetCell(100U, 50U, true);
+  world.SetCell(115U, 57U, true);
+  world.SetCell(99U, 50U, true);  // Outside the window.
+
+  WorldViewport viewport;
+  viewport.MoveTo(100U, 50U);
+
+  FakeDisplay<16U, 8U> display;
+  viewport.Render(world, display);
+
+  EXPECT_EQ(display.calls, 16U * 8U);
+  for (std::uint16_t coord_y{0U}; coord_y < 8U; ++coord_y) {
+    for (std::uint16_t coord_x{0U}; coord_x < 16U; ++coord_x) {
+      const bool expected{((coord_x == 0U) && (coord_y == 0U)) || ((coord_x == 15U) && (coord_y == 7U))};
+      EXPECT_EQ(display.pixels[coord_y][coord_x], expected) << "x=" << coord_x << ", y=" << coord_y;
+    }
+  }
+}
+
+TEST(ViewportTest, FollowsActivity) {
+  World world;
+  // A blinker in the bottom-right corner of the world.
+  world.SetCell(240U, 119U, true);
+  world.SetCell(240U, 120U, true);
+  world.SetCell(240U, 121U, true);
+
+  WorldViewport viewport;
+  viewport.MoveTo(0U, 0U);
+
+  constexpr std::uint32_t kIterations{200U};
+  for (std::uint32_t i{0U}; i < kIterations; ++i) {
+    world.UpdateGameGrid();
+    const auto prev_x = viewport.GetOriginX();
+    viewport.Follow(world);
+    ASSERT_LE(viewport.GetOriginX() - prev_x, WorldViewport::kMaxPanStep);
+  }
+
+  // The blinker ends up inside the window.
+  EXPECT_LE(viewport.GetOriginX(), 240U);
+  EXPECT_GT(viewport.GetOriginX() + WorldViewport::kViewWidth, 240U);
+  EXPECT_EQ(viewport.GetOriginY(), 116U);
+}
+
+TEST(ViewportTest, FollowsOneOfDistantOscillators) {
+  using LargeWorld = BitPackedGameOfLife<256U, 256U>;
+  using LargeViewport = Viewport<LargeWorld, 128U, 64U>;
+
+  // Two blinkers in opposite corners: the mean of their positions is empty space.
+  constexpr std::array<std::array<std::uint16_t, 2>, 2> kBlinkers{{{10U, 10U}, {245U, 240U}}};
+  LargeWorld world;
+  for (const auto& blinker : kBlinkers) {
+    world.SetCell(blinker[0], blinker[1] - 1U, true);
+    world.SetCell(blinker[0], blinker[1], true);
+    world.SetCell(blinker[0], blinker[1] + 1U, true);
+  }
+
+  LargeViewport viewport;
+  constexpr std::uint32_t kIterations{300U};
+  for (std::uint32_t i{0U}; i < kIterations; ++i) {
+    world.UpdateGameGrid();
+    viewport.Follow(world);
+  }
+
+  const auto in_view = [&viewport](const std::array<std::uint16_t, 2>& blinker) {
+    return (blinker[0] >= viewport.GetOriginX()) && (blinker[0] < viewport.GetOriginX() + LargeViewport::kViewWidth) &&
+           (blinker[1] >= viewport.GetOriginY()) && (blinker[1] < viewport.GetOriginY() + LargeViewport::kViewHeight);
+  };
+  EXPECT_TRUE(in_view(kBlinkers[0]) || in_view(kBlinkers[1]))
+      << "origin=(" << viewport.GetOriginX() << ", " << viewport.GetOriginY() << ")";
+
+  // The viewport sticks to the block it follows instead of alternating between the blinkers.
+  const auto origin_x = viewport.GetOriginX();
+  const auto origin_y = viewport.GetOriginY();
+  world.UpdateGameGrid();
+  viewport.Follow(world);
+  EXPECT_EQ(viewport.GetOriginX(), origin_x);
+  EXPECT_EQ(viewport.GetOriginY(), origin_y);
+}
+
+TEST(ViewportTest, StaysWithoutActivity) {
+  World world;
+  WorldViewport viewport;
+  viewport.MoveTo(10U, 20U);
+
+  world.UpdateGameGrid();
+  viewport.Follow(world);
+
+  EXPECT_EQ(viewport.GetOriginX(), 10U);
+  EXPECT_EQ(viewport.GetOriginY(), 20U);
+}